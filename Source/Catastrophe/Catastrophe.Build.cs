@@ -11,7 +11,8 @@ public class Catastrophe : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] {
             "Core", "CoreUObject", "Engine", "InputCore", "UMG",
             "CableComponent", "ApexDestruction",
-            "AIModule", "GameplayTasks", "NavigationSystem" });
+            "AIModule", "GameplayTasks", "NavigationSystem",
+            "ProceduralMeshComponent" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {
             "CableComponent", "ApexDestruction" });
@@ -6,4 +6,5 @@
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Catastrophe, "Catastrophe" );
 
 DEFINE_LOG_CATEGORY(LogQuestSystem);
-DEFINE_LOG_CATEGORY(LogSaveGameSystem);
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogSaveGameSystem);
+DEFINE_LOG_CATEGORY(LogNoiseSystem);
\ No newline at end of file
@@ -5,4 +5,5 @@
 #include "CoreMinimal.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogQuestSystem, All, All);
-DECLARE_LOG_CATEGORY_EXTERN(LogSaveGameSystem, All, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogSaveGameSystem, All, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogNoiseSystem, All, All);
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/SpotLightComponent.h"
 #include "Classes/BehaviorTree/BlackboardComponent.h"
+#include "BrainComponent.h"
+#include "Navigation/PathFollowingComponent.h"
 
 #include "Engine/World.h"
 #include "TimerManager.h"
@@ -26,6 +28,8 @@
 
 #include "Gameplay/GameMode/CatastropheMainGameMode.h"
 #include "RespawnSystem/RespawnSubsystem.h"
+#include "NoiseSystem/NoisePropagationSubsystem.h"
+#include "ViewContextSystem/ViewContextSubsystem.h"
 
 #include "DebugUtility/CatastropheDebug.h"
 
@@ -144,30 +148,47 @@ void AGuard::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	UpdateChaseConverge();
+
+	UViewContextSubsystem* viewContextSystem = UViewContextSubsystem::GetInst(this);
+	if (!viewContextSystem || !viewContextSystem->GetViewContext().bValid)
+		return;
+	const FGameplayViewContext& viewContext = viewContextSystem->GetViewContext();
+
 	// Rotate the headshot target plane towards the camera
 	// As well as self rotating
 	{
 		FRotator headShotTargetRot = UKismetMathLibrary::FindLookAtRotation(
 			HeadShotTargetAnchor->GetComponentLocation(), 
-			UGameplayStatics::GetPlayerCameraManager(this, 0)->GetCameraLocation());
+			viewContext.CameraLocation);
 		HeadShotTargetAnchor->SetWorldRotation(headShotTargetRot);
 
 	}
 
 	// Guard Hearing detection tick
-	if (bPlayerInSleepDetectRange)
+	if (IsValid(PlayerRef))
 	{
-		if (
-			IsValid(PlayerRef) &&
-			PlayerRef->GetVelocity().Size() >= 100.0f &&
-			!PlayerRef->GetCharacterMovement()->IsCrouching())
-		{
-			GuardController->GetBlackboardComponent()->SetValueAsBool(TEXT("bHearingPlayer"), true);
-		}
-		else
+		const bool bPlayerMakingNoise =
+			viewContext.PlayerVelocity.Size() >= 100.0f &&
+			!viewContext.bPlayerCrouching;
+
+		// Use the baked noise field if the level has one, so the noise does not go through walls
+		bool bHasNoiseField = false;
+		bool bNoiseReached = false;
+		if (UNoisePropagationSubsystem* noiseSystem = UNoisePropagationSubsystem::GetInst(this))
 		{
-			GuardController->GetBlackboardComponent()->SetValueAsBool(TEXT("bHearingPlayer"), false);
+			bNoiseReached = noiseSystem->CanNoiseReach(
+				viewContext.PlayerLocation, 
+				GetActorLocation(), 
+				HearingNoiseRadius, 
+				bHasNoiseField);
 		}
+
+		// Always written, so leaving the field or the hearing trigger does not leave the guard hearing the player
+		const bool bHearingPlayer = bHasNoiseField ?
+			bPlayerMakingNoise && bNoiseReached :
+			bPlayerMakingNoise && bPlayerInSleepDetectRange;
+		GuardController->GetBlackboardComponent()->SetValueAsBool(TEXT("bHearingPlayer"), bHearingPlayer);
 	}
 
 }
@@ -185,6 +206,54 @@ void AGuard::GetActorEyesViewPoint(FVector& Location, FRotator& Rotation) const
 	GetPerceptionLocRot(Location, Rotation);
 }
 
+void AGuard::OnSnapshotRestored_Implementation()
+{
+	// The stun and wake up timers belong to the state before the reset
+	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+	GetCharacterMovement()->StopMovementImmediately();
+	StopAllMontages();
+
+	// The chase and the indicators belong to the state before the reset, which the snapshot has overwritten
+	if (ACatastropheMainGameMode* gamemode = ACatastropheMainGameMode::GetGameModeInst(this))
+		gamemode->RemoveOneChasingGuard(this);
+	ToggleAlertIndicator(false);
+	ToggleQuestionIndicator(false);
+	ToggleZzzIndicator(false);
+	HeadLight->SetVisibility(true);
+	CatchHitBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	if (GuardAnimInstance)
+	{
+		GuardAnimInstance->bStuned = false;
+		GuardAnimInstance->bSleeping = false;
+	}
+
+	// The restored state is usually the neutral state already, so the state change is forced to run its enter logic
+	const EGuardState restoredState = GuardState;
+	GuardState = PreferNeutralState;
+	OnGuardStateChange(restoredState, PreferNeutralState);
+
+	if (GuardController)
+	{
+		GuardController->StopMovement();
+		GuardController->SetGuardSenseEnable_Sight(true, true);
+		if (UBlackboardComponent* blackboard = GuardController->GetBlackboardComponent())
+		{
+			blackboard->SetValueAsEnum(TEXT("GuardState"), (uint8)PreferNeutralState);
+			blackboard->SetValueAsBool(TEXT("bStunned"), false);
+			blackboard->SetValueAsBool(TEXT("bCaughtPlayer"), false);
+			blackboard->SetValueAsBool(TEXT("bFullyAlerted"), false);
+			blackboard->SetValueAsBool(TEXT("bHearingPlayer"), false);
+			blackboard->SetValueAsFloat(TEXT("CurrentAlertedTime"), 0.0f);
+			blackboard->SetValueAsInt(TEXT("PatrolPointIndex"), 0);
+			blackboard->ClearValue(TEXT("PointOfInterest"));
+			blackboard->ClearValue(TEXT("PlayerLastSeenLocation"));
+		}
+		if (UBrainComponent* brain = GuardController->GetBrainComponent())
+			brain->RestartLogic();
+	}
+}
+
 void AGuard::SetGuardState(EGuardState _newState)
 {
 	// If switching to the same state, ignore it
@@ -398,6 +467,126 @@ void AGuard::OnCatchPlayerFailed_Implementation()
 
 }
 
+void AGuard::SetChaseSlotGranted(bool _bGranted)
+{
+	if (bHasChaseSlot == _bGranted)
+		return;
+	bHasChaseSlot = _bGranted;
+
+	// Guards without a slot does not need to think every frame
+	const float tickInterval = _bGranted ? 0.0f : UnslottedChaseTickInterval;
+	SetActorTickInterval(tickInterval);
+	GetCharacterMovement()->SetComponentTickInterval(_bGranted ? 0.0f : UnslottedMovementTickInterval);
+
+	if (GuardController)
+	{
+		GuardController->SetActorTickInterval(tickInterval);
+
+		// The behaviour tree is suspended, the converge move is issued from code instead
+		if (_bGranted)
+			GuardController->StopMovement();
+		SetLogicPaused(EGuardLogicPause::ChaseSlot, !_bGranted);
+	}
+
+	bHasChaseConvergeMove = false;
+}
+
+void AGuard::SetChaseConvergeLocation(const FVector& _location)
+{
+	if (bHasChaseSlot || !GuardController)
+		return;
+
+	// Only move again when the location has changed, the path query is the expensive part
+	if (bHasChaseConvergeMove && 
+		FVector::DistSquared(ChaseConvergeLocation, _location) <= FMath::Square(ChaseConvergeAcceptanceRadius))
+	{
+		return;
+	}
+
+	ChaseConvergeLocation = _location;
+	bHasChaseConvergeMove = true;
+	GuardController->MoveToLocation(ChaseConvergeLocation, ChaseConvergeAcceptanceRadius);
+}
+
+void AGuard::UpdateChaseConverge()
+{
+	if (bHasChaseSlot || !bHasChaseConvergeMove || GuardState != EGuardState::CHASING || !GuardController)
+		return;
+
+	// The guard has reached the last known location without seeing the player, it gives up the chase
+	if (GuardController->GetMoveStatus() == EPathFollowingStatus::Idle && !bPlayerInSight)
+	{
+		if (UBlackboardComponent* blackboard = GuardController->GetBlackboardComponent())
+			blackboard->SetValueAsEnum(TEXT("GuardState"), (uint8)EGuardState::SEARCHING);
+
+		// Leaving the chase gives the slot back, which resumes the behaviour tree
+		SetGuardState(EGuardState::SEARCHING);
+		if (UBrainComponent* brain = GuardController->GetBrainComponent())
+			brain->RestartLogic();
+	}
+}
+
+void AGuard::SetPatrolGroup(class AGuardPatrolGroup* _patrolGroup)
+{
+	PatrolGroup = _patrolGroup;
+
+	if (PatrolGroup)
+		SetGuardMaxSpeed(PatrolSpeed);
+	else
+		SetFollowingPatrolGroup(false);
+}
+
+void AGuard::SetFollowingPatrolGroup(bool _bFollowing)
+{
+	if (bFollowingPatrolGroup == _bFollowing || !GuardController)
+		return;
+	bFollowingPatrolGroup = _bFollowing;
+
+	// The own patrol route of the behaviour tree would fight the formation moves
+	// Start over once resumed so the tree reacts to whatever made the guard break the formation
+	if (SetLogicPaused(EGuardLogicPause::PatrolGroup, _bFollowing))
+	{
+		if (UBrainComponent* brain = GuardController->GetBrainComponent())
+			brain->RestartLogic();
+	}
+}
+
+bool AGuard::SetLogicPaused(EGuardLogicPause _reason, bool _bPaused)
+{
+	const EGuardLogicPause oldReasons = LogicPauseReasons;
+	if (_bPaused)
+		LogicPauseReasons |= _reason;
+	else
+		LogicPauseReasons &= ~_reason;
+
+	UBrainComponent* brain = GuardController ? GuardController->GetBrainComponent() : nullptr;
+	if (!brain)
+		return false;
+
+	// Only the first reason pauses and only the last one resumes, so one reason cannot undo another
+	if (oldReasons == EGuardLogicPause::None && LogicPauseReasons != EGuardLogicPause::None)
+	{
+		brain->PauseLogic(TEXT("Guard"));
+	}
+	else if (oldReasons != EGuardLogicPause::None && LogicPauseReasons == EGuardLogicPause::None)
+	{
+		brain->ResumeLogic(TEXT("Guard"));
+		return true;
+	}
+	return false;
+}
+
+bool AGuard::HasPatrolDisturbance() const
+{
+	if (bPlayerInSight)
+		return true;
+
+	UBlackboardComponent* blackboard = GuardController ? GuardController->GetBlackboardComponent() : nullptr;
+	return blackboard &&
+		(blackboard->GetValueAsBool(TEXT("bHearingPlayer")) ||
+		blackboard->IsVectorValueSet(TEXT("PointOfInterest")));
+}
+
 void AGuard::ResetGuard()
 {
 	GetCharacterMovement()->DisableMovement();
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Perception/AIPerceptionTypes.h"
+#include "RespawnSystem/ResettableActorInterface.h"
 #include "Guard.generated.h"
 
 
@@ -28,11 +29,20 @@ enum class EGuardState : uint8
 	STUNED,
 };
 
+/** The reasons the behaviour tree of a guard can be paused for, it only resumes once none is held */
+enum class EGuardLogicPause : uint8
+{
+	None		= 0,
+	ChaseSlot	= 1 << 0,
+	PatrolGroup	= 1 << 1
+};
+ENUM_CLASS_FLAGS(EGuardLogicPause)
+
 /**
  * This character is the main enemy that trying to guard around places and catches the player
  */
 UCLASS()
-class CATASTROPHE_API AGuard : public ACharacter
+class CATASTROPHE_API AGuard : public ACharacter, public IResettableActorInterface
 {
 	GENERATED_BODY()
 
@@ -109,6 +119,10 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Guard | References")
 	class ACatastropheMainGameMode* CatastropheGameMode;
 
+	/** The patrol group this guard is following, nullptr if the guard patrols on its own */
+	UPROPERTY(BlueprintReadOnly, Category = "Guard | References")
+	class AGuardPatrolGroup* PatrolGroup;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Guard | General")
 	FTransform DefaultTransform;
 
@@ -128,9 +142,31 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Perception")
 	float LosingSightRange = 500.0f;
 
+	/**
+	 * How far along the nav mesh the player's footsteps can be heard
+	 * Only used in levels with a baked noise field, otherwise the HearingTrigger is used
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Perception")
+	float HearingNoiseRadius = 800.0f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Chase")
 	float TimeToFullyAlert = 1.0f;
 
+	/**
+	 * Tick interval of the guard and its controller when chasing without a chase slot
+	 * @see ACatastropheMainGameMode::UpdateChaseSlots
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Chase")
+	float UnslottedChaseTickInterval = 0.25f;
+
+	/** Tick interval of the character movement when chasing without a chase slot, kept low so the movement stays smooth */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Chase")
+	float UnslottedMovementTickInterval = 0.05f;
+
+	/** How close a guard without a chase slot gets to the last known location of the player */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Chase")
+	float ChaseConvergeAcceptanceRadius = 100.0f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Guard | Stats | Stun")
 	float MaxStunTime = 5.0f;
 
@@ -168,6 +204,22 @@ private:
 	UPROPERTY(BlueprintReadWrite, Category = "Guard | Behaviour | Sleep", meta = (AllowPrivateAccess = "true"))
 	FTimerHandle WakeUpStageOneTimerHandle;
 
+	/** If this guard is allowed to run the full cost chase behaviour */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Guard | Behaviour | Chase", meta = (AllowPrivateAccess = "true"))
+	bool bHasChaseSlot = true;
+
+	/** The location the guard moves to while chasing without a chase slot */
+	FVector ChaseConvergeLocation;
+
+	/** True once the converge move has been issued since the slot was revoked */
+	bool bHasChaseConvergeMove = false;
+
+	/** True while the behaviour tree is paused for the patrol group to move the guard */
+	bool bFollowingPatrolGroup = false;
+
+	/** The reasons the behaviour tree is currently paused for */
+	EGuardLogicPause LogicPauseReasons = EGuardLogicPause::None;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -197,6 +249,9 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "Guard | General", meta = (DisplayName = "OnSendingPlayerToJail"))
 	void Receive_OnSendingPlayerToJail();
 
+	/** Gives up the chase once a guard without a chase slot has reached the converge location without seeing the player */
+	void UpdateChaseConverge();
+
 	/** Called when the catch hit box overlap */
 	UFUNCTION()
 	virtual void OnCatchHitBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -211,6 +266,9 @@ public:
 	/** Called to get the eye view point of the character */
 	virtual void GetActorEyesViewPoint(FVector& Location, FRotator& Rotation) const override;
 
+	/** Called after the level of the guard has been reset, starts the behaviour over */
+	virtual void OnSnapshotRestored_Implementation() override;
+
 	/**
 	 * Sets the state of the guard then modify the character value base on the state
 	 * @author Richard Wulansari
@@ -268,6 +326,21 @@ public:
 	void OnCatchPlayerFailed();
 	virtual void OnCatchPlayerFailed_Implementation();
 
+	/**
+	 * Called by the gamemode to grant or revoke the full cost chase behaviour
+	 * Guards without a slot have their behaviour tree paused, tick at a lower rate and move to the last known player location
+	 * @author Richard Wulansari
+	 * @param _bGranted Does the guard have the chase slot
+	 */
+	void SetChaseSlotGranted(bool _bGranted);
+
+	/**
+	 * Sets the location the guard will converge to when chasing without a chase slot
+	 * @author Richard Wulansari
+	 * @param _location The last known location of the player
+	 */
+	void SetChaseConvergeLocation(const FVector& _location);
+
 	/** Called to reset everything of the guard */
 	UFUNCTION(BlueprintCallable, Category = "Guard | General")
 	void ResetGuard();
@@ -281,6 +354,23 @@ public:
 		GuardController = _controller;
 	}
 
+	/**
+	 * Sets the patrol group that this guard follows
+	 * @author Richard Wulansari
+	 * @param _patrolGroup The group, nullptr to leave the group
+	 */
+	void SetPatrolGroup(class AGuardPatrolGroup* _patrolGroup);
+
+	/**
+	 * Pauses the behaviour tree while the patrol group moves the guard, resumes it when the guard breaks the formation
+	 * @author Richard Wulansari
+	 * @param _bFollowing
+	 */
+	void SetFollowingPatrolGroup(bool _bFollowing);
+
+	/** Check if the guard has sensed something its behaviour tree has to react to, e.g. the player or a yarn ball */
+	bool HasPatrolDisturbance() const;
+
 	/** Sets the prefered neutral state of the guard */
 	void SetPreferNeutralState(EGuardState _state) { PreferNeutralState = _state; }
 
@@ -288,6 +378,8 @@ public:
 	FORCEINLINE EGuardState GetGuardState() const { return GuardState; }
 	FORCEINLINE EGuardState GetPreferNeutralState() const { return PreferNeutralState; }
 	FORCEINLINE class AGuardAiController* GetGuardController() const { return GuardController; }
+	FORCEINLINE bool HasChaseSlot() const { return bHasChaseSlot; }
+	FORCEINLINE class AGuardPatrolGroup* GetPatrolGroup() const { return PatrolGroup; }
 	/** Getter End */
 
 private:
@@ -300,4 +392,13 @@ private:
 	UFUNCTION()
 	void OnPlayerAimingEnd();
 
+	/**
+	 * Holds or releases a reason to pause the behaviour tree, the tree is paused while any reason is held
+	 * @author Richard Wulansari
+	 * @param _reason
+	 * @param _bPaused
+	 * @return True if the tree has been resumed by this call
+	 */
+	bool SetLogicPaused(EGuardLogicPause _reason, bool _bPaused);
+
 };
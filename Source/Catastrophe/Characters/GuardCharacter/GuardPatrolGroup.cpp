@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GuardPatrolGroup.h"
+
+#include "NavigationSystem.h"
+#include "NavigationPath.h"
+
+#include "Guard.h"
+#include "GuardAiController.h"
+
+// Sets default values
+AGuardPatrolGroup::AGuardPatrolGroup()
+{
+	// Tick is used to move the leader cursor, the interval is set at BeginPlay
+	PrimaryActorTick.bCanEverTick = true;
+
+	DefaultSceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRoot"));
+	RootComponent = DefaultSceneRoot;
+}
+
+// Called when the game starts or when spawned
+void AGuardPatrolGroup::BeginPlay()
+{
+	Super::BeginPlay();
+
+	SetActorTickInterval(FormationUpdateInterval);
+
+	// Let the members know they are following a group instead of their own route
+	for (AGuard* guard : MemberGuards)
+	{
+		if (IsValid(guard))
+			guard->SetPatrolGroup(this);
+	}
+
+	// The nav mesh might not be ready yet when streamed in, tick will try again
+	PathBuildRetryDelay = MinPathBuildRetryDelay;
+	if (!BuildCachedPath())
+		NextPathBuildTime = GetWorld()->GetTimeSeconds() + PathBuildRetryDelay;
+}
+
+void AGuardPatrolGroup::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	for (AGuard* guard : MemberGuards)
+	{
+		if (IsValid(guard))
+			guard->SetPatrolGroup(nullptr);
+	}
+}
+
+// Called every frame
+void AGuardPatrolGroup::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (CachedPathPoints.Num() < 2)
+	{
+		// Each attempt is a path query per leg, back off while the nav mesh is not ready
+		const float currentTime = GetWorld()->GetTimeSeconds();
+		if (currentTime < NextPathBuildTime)
+			return;
+
+		if (!BuildCachedPath())
+		{
+			NextPathBuildTime = currentTime + PathBuildRetryDelay;
+			PathBuildRetryDelay = FMath::Min(PathBuildRetryDelay * 2.0f, MaxPathBuildRetryDelay);
+			return;
+		}
+		PathBuildRetryDelay = MinPathBuildRetryDelay;
+	}
+
+	// The cursor only moves when the leader is keeping up
+	AGuard* leader = MemberGuards.Num() > 0 ? MemberGuards[0] : nullptr;
+	if (IsValid(leader) && IsGuardInFormationState(leader))
+	{
+		FVector cursorLocation, cursorDirection;
+		GetCursorLocationAndDirection(cursorLocation, cursorDirection);
+		const float leaderLag = FVector::Dist2D(leader->GetActorLocation(), cursorLocation);
+		if (leaderLag <= MaxLeaderLagDistance)
+		{
+			const float totalLength = CachedPathDistances.Last();
+			CursorDistance += CursorSpeed * DeltaTime;
+
+			// The route is a loop, so wrap around to the start
+			if (CursorDistance >= totalLength)
+			{
+				CursorDistance = FMath::Fmod(CursorDistance, totalLength);
+				CursorSegmentIndex = 0;
+			}
+			while (CursorSegmentIndex < CachedPathDistances.Num() - 2 &&
+				CachedPathDistances[CursorSegmentIndex + 1] < CursorDistance)
+			{
+				CursorSegmentIndex++;
+			}
+		}
+	}
+
+	// Move each member towards its formation slot, no path query needed as the slot stays near the cached path
+	FVector cursorLocation, cursorDirection;
+	GetCursorLocationAndDirection(cursorLocation, cursorDirection);
+	const FRotator cursorRotation = cursorDirection.Rotation();
+	for (int32 i = 0; i < MemberGuards.Num(); ++i)
+	{
+		AGuard* guard = MemberGuards[i];
+		if (!IsValid(guard))
+			continue;
+
+		// The behaviour tree of the member only runs while it is out of the formation
+		const bool bFollowing = IsGuardInFormationState(guard) && !guard->HasPatrolDisturbance();
+		guard->SetFollowingPatrolGroup(bFollowing);
+		if (!bFollowing)
+			continue;
+
+		AGuardAiController* controller = guard->GetGuardController();
+		if (!controller)
+			continue;
+
+		const FVector offset = FormationOffsets.IsValidIndex(i) ? FormationOffsets[i] : FVector::ZeroVector;
+		const FVector slotLocation = cursorLocation + cursorRotation.RotateVector(offset);
+		controller->MoveToLocation(
+			slotLocation,
+			FormationAcceptanceRadius,
+			false,
+			false); // No pathfinding
+	}
+}
+
+bool AGuardPatrolGroup::IsGuardInFormationState(const AGuard* _guard)
+{
+	// Any alert state breaks the formation
+	const EGuardState state = _guard->GetGuardState();
+	return state == EGuardState::STATIONARY || state == EGuardState::PATROLLING;
+}
+
+bool AGuardPatrolGroup::BuildCachedPath()
+{
+	CachedPathPoints.Reset();
+	CachedPathDistances.Reset();
+	CursorDistance = 0.0f;
+	CursorSegmentIndex = 0;
+
+	if (PatrolLocations.Num() < 2)
+		return false;
+
+	UNavigationSystemV1* navSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!navSystem)
+		return false;
+
+	// One query per leg, the legs get stitched into a single cached route
+	const FTransform& actorTransform = GetActorTransform();
+	for (int32 i = 0; i < PatrolLocations.Num(); ++i)
+	{
+		const FVector legStart = actorTransform.TransformPosition(PatrolLocations[i]);
+		const FVector legEnd = actorTransform.TransformPosition(PatrolLocations[(i + 1) % PatrolLocations.Num()]);
+
+		UNavigationPath* legPath = navSystem->FindPathToLocationSynchronously(this, legStart, legEnd, this);
+		if (!legPath || !legPath->IsValid())
+		{
+			CachedPathPoints.Reset();
+			return false;
+		}
+
+		// Skip the first point of each leg after the first as it is the end of the previous leg
+		const int32 firstPoint = CachedPathPoints.Num() > 0 ? 1 : 0;
+		for (int32 p = firstPoint; p < legPath->PathPoints.Num(); ++p)
+		{
+			CachedPathPoints.Add(legPath->PathPoints[p]);
+		}
+	}
+
+	// Accumulate the distances for the cursor lookup
+	CachedPathDistances.Reserve(CachedPathPoints.Num());
+	CachedPathDistances.Add(0.0f);
+	for (int32 i = 1; i < CachedPathPoints.Num(); ++i)
+	{
+		CachedPathDistances.Add(CachedPathDistances[i - 1] +
+			FVector::Dist(CachedPathPoints[i - 1], CachedPathPoints[i]));
+	}
+
+	if (CachedPathDistances.Last() <= KINDA_SMALL_NUMBER)
+	{
+		CachedPathPoints.Reset();
+		CachedPathDistances.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void AGuardPatrolGroup::GetCursorLocationAndDirection(FVector& _outLocation, FVector& _outDirection) const
+{
+	const int32 segment = FMath::Clamp(CursorSegmentIndex, 0, CachedPathPoints.Num() - 2);
+	const FVector& segmentStart = CachedPathPoints[segment];
+	const FVector& segmentEnd = CachedPathPoints[segment + 1];
+	const float segmentLength = CachedPathDistances[segment + 1] - CachedPathDistances[segment];
+	const float alpha = segmentLength > KINDA_SMALL_NUMBER ?
+		FMath::Clamp((CursorDistance - CachedPathDistances[segment]) / segmentLength, 0.0f, 1.0f) : 0.0f;
+
+	_outLocation = FMath::Lerp(segmentStart, segmentEnd, alpha);
+	_outDirection = (segmentEnd - segmentStart).GetSafeNormal2D();
+	if (_outDirection.IsNearlyZero())
+		_outDirection = GetActorForwardVector();
+}
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "GuardPatrolGroup.generated.h"
+
+/**
+ * This actor owns a single patrol route shared by a group of guards
+ * The route is path queried once per leg, then all the member guards follow formation offsets
+ * from a leader cursor that moves along the cached path
+ */
+UCLASS()
+class CATASTROPHE_API AGuardPatrolGroup : public AActor
+{
+	GENERATED_BODY()
+
+private:
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class USceneComponent* DefaultSceneRoot;
+
+public:
+	// Sets default values for this actor's properties
+	AGuardPatrolGroup();
+
+protected:
+
+	/** The patrol way points of the group, relative to this actor */
+	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "PatrolGroup", meta = (MakeEditWidget = "true"))
+	TArray<FVector> PatrolLocations;
+
+	/** Guards that patrol together in this group, the first guard is the leader */
+	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "PatrolGroup")
+	TArray<class AGuard*> MemberGuards;
+
+	/**
+	 * Formation offset of each member relative to the leader cursor
+	 * X is forward along the path, Y is to the right
+	 * @note Members without an offset will follow directly on the cursor
+	 */
+	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "PatrolGroup")
+	TArray<FVector> FormationOffsets;
+
+	/** Speed of the leader cursor along the path */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PatrolGroup")
+	float CursorSpeed = 250.0f;
+
+	/** The cursor stops when the leader falls behind more than this distance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PatrolGroup")
+	float MaxLeaderLagDistance = 300.0f;
+
+	/** The acceptance radius when members move towards their formation slot */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PatrolGroup")
+	float FormationAcceptanceRadius = 30.0f;
+
+	/** How often the members get their formation slot updated */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PatrolGroup")
+	float FormationUpdateInterval = 0.2f;
+
+	/** The first delay before the route is queried again after a failed query, it doubles on each failure */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PatrolGroup")
+	float MinPathBuildRetryDelay = 1.0f;
+
+	/** The longest delay between two queries of the route */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PatrolGroup")
+	float MaxPathBuildRetryDelay = 16.0f;
+
+private:
+
+	/** Cached world space points of the whole route, the result of the single path query */
+	TArray<FVector> CachedPathPoints;
+
+	/** Accumulated distance along the route at each cached path point */
+	TArray<float> CachedPathDistances;
+
+	/** Distance of the leader cursor along the cached path */
+	float CursorDistance = 0.0f;
+
+	/** The index of the path segment the cursor is currently on */
+	int32 CursorSegmentIndex = 0;
+
+	/** The delay before the next query of the route if the current one fails */
+	float PathBuildRetryDelay = 1.0f;
+
+	/** The world time the route may be queried again at */
+	float NextPathBuildTime = 0.0f;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/** Called when the actor has destroyed */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * Check if the guard is following the formation or has broken away
+	 * @author Richard Wulansari
+	 * @param _guard The member guard
+	 * @return True if the guard should be following the formation
+	 */
+	UFUNCTION(BlueprintCallable, Category = "PatrolGroup")
+	static bool IsGuardInFormationState(const class AGuard* _guard);
+
+	/** Getter */
+	FORCEINLINE const TArray<FVector>& GetCachedPathPoints() const { return CachedPathPoints; }
+	/** Getter End */
+
+private:
+
+	/**
+	 * Runs the path query of the route and caches the result
+	 * @author Richard Wulansari
+	 * @return True if the path is successfully built
+	 */
+	bool BuildCachedPath();
+
+	/**
+	 * Gets the location and forward direction of the cursor on the cached path
+	 * @author Richard Wulansari
+	 */
+	void GetCursorLocationAndDirection(FVector& _outLocation, FVector& _outDirection) const;
+
+};
@@ -25,7 +25,7 @@ ANPC::ANPC()
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
 	InteractableComponent->InteractionDescriptionText = TEXT("Talk");
-	InteractableComponent->RegisterTriggerVolume(TriggerBox);
+	InteractableComponent->RegisterTriggerVolume(TriggerBox, true);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &ANPC::Interact);
 
 	DialogueSystemComponent = CreateDefaultSubobject<UDialogueSystemComponent>(TEXT("DialogueSystemComponent"));
@@ -6,7 +6,6 @@
 #include "Components/InputComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
-#include "Components/TimelineComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Components/PostProcessComponent.h"
 #include "Classes/Particles/ParticleSystemComponent.h"
@@ -20,9 +19,11 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "GameFramework/PlayerController.h"
+#include "TimerManager.h"
 
 #include "Gameplay/GameMode/CatastropheMainGameMode.h"
 #include "PlayerWidget.h"
+#include "PlayerHudModel.h"
 #include "PlayerAnimInstance.h"
 #include "Components/MovementModifierComponent.h"
 #include "Components/CharacterSprintMovementComponent.h"
@@ -32,7 +33,10 @@
 #include "Gameplay/CaveGameplay/CaveCameraTrack.h"
 #include "ThrowableProjectileIndicator.h"
 #include "Components/InventoryComponent.h"
+#include "Components/ThrowTrajectoryComponent.h"
+#include "Components/CameraEffectsComponent.h"
 #include "UtilitySacks/TomatoSack.h"
+#include "ViewContextSystem/ViewContextSubsystem.h"
 
 #include "DebugUtility/CatastropheDebug.h"
 
@@ -81,9 +85,14 @@ APlayerCharacter::APlayerCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
+	// Blends the camera effects, only ticks while an effect is blending
+	CameraEffectsComponent = CreateDefaultSubobject<UCameraEffectsComponent>(TEXT("CameraEffectsComponent"));
+
 	// Holds player utilities
 	InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("InventoryComponent"));
 
+	HudModel = CreateDefaultSubobject<UPlayerHudModel>(TEXT("HudModel"));
+
 	// Back pack which holds the player collected items
 	BackPackComponent = CreateDefaultSubobject<UBackPackComponent>(TEXT("BackPackComponent"));
 
@@ -91,6 +100,9 @@ APlayerCharacter::APlayerCharacter()
 	ThrowableSpawnPoint = CreateDefaultSubobject<USceneComponent>(TEXT("TomatoSpawnPoint"));
 	ThrowableSpawnPoint->SetupAttachment(GetMesh());
 
+	// Predicts the arc of the throwable objects during aiming
+	ThrowTrajectoryComponent = CreateDefaultSubobject<UThrowTrajectoryComponent>(TEXT("ThrowTrajectoryComponent"));
+
 	// Set the tomato that will show inside players hand
 	TomatoInHandMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TomatoInHandMesh"));
 	TomatoInHandMesh->SetupAttachment(GetMesh(), TEXT("RightHandSocket"));
@@ -130,21 +142,6 @@ void APlayerCharacter::BeginPlay()
 	if (!PlayerAnimInstance)
 		CatastropheDebug::OnScreenErrorMsg(TEXT("PlayerCharacter: Invalid anim instance"));
 
-	// Construct the zoom in timeline
-	{
-		if (!ZoomInCurve) UE_LOG(LogTemp, Error, TEXT("Player zoom in curve is nullptr!"));
-		ZoomInTimeline = NewObject<UTimelineComponent>(this, TEXT("ZoomInTimeline"));
-		ZoomInTimeline->CreationMethod = EComponentCreationMethod::UserConstructionScript;
-		this->BlueprintCreatedComponents.Add(ZoomInTimeline);
-		ZoomInTimeline->SetLooping(false);
-		ZoomInTimeline->SetTimelineLength(0.3f);
-		ZoomInTimeline->SetTimelineLengthMode(ETimelineLengthMode::TL_LastKeyFrame);
-		FOnTimelineFloat onTimelineCallback;
-		onTimelineCallback.BindUFunction(this, FName{ TEXT("TimelineSetCameraZoomValue") });
-		ZoomInTimeline->AddInterpFloat(ZoomInCurve, onTimelineCallback);
-		ZoomInTimeline->RegisterComponent();
-	}
-	
 	// Set the stamina to full
 	SetStamina(TotalStamina);
 
@@ -154,21 +151,20 @@ void APlayerCharacter::BeginPlay()
 	PlayerDefaultValues.CameraFOV = FollowCamera->FieldOfView;
 	PlayerDefaultValues.CameraArmLength = CameraBoom->TargetArmLength;
 
+	// Configure the camera effects, the aim zoom uses the HHU zoom curve
+	if (!ZoomInCurve) UE_LOG(LogTemp, Error, TEXT("Player zoom in curve is nullptr!"));
+	FCameraEffectLayer& aimZoomLayer = CameraEffectsComponent->Layers[(int32)ECameraEffectLayer::AimZoom];
+	aimZoomLayer.BlendCurve = ZoomInCurve;
+	aimZoomLayer.ArmLengthMultiplier = CameraZoomMultiplier;
+	CameraEffectsComponent->SetLayerPostProcess(ECameraEffectLayer::SprintFov, SprintingPostProcess);
+	CameraEffectsComponent->SetLayerPostProcess(ECameraEffectLayer::Hiding, HidingPostProcess);
+	CameraEffectsComponent->Initialize(FollowCamera, CameraBoom, PlayerDefaultValues.CameraFOV, PlayerDefaultValues.CameraArmLength);
+
 	// Check if theres tomato in player's hand
 	CheckTomatoInHand();
 
-	// Spawn the projectile indicator actor
-	if (ThrowableProjectilIndicatorClass)
-	{
-		FActorSpawnParameters spawnParam;
-		spawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		ThrowableProjectilIndicator =
-			GetWorld()->SpawnActor<AThrowableProjectileIndicator>(
-				ThrowableProjectilIndicatorClass, 
-				FTransform::Identity,
-				spawnParam);
-	}
-	else
+	// The projectile indicator is spawned on the first aim
+	if (!ThrowableProjectilIndicatorClass)
 	{
 		CatastropheDebug::OnScreenErrorMsg(TEXT("PlayerCharacter: Missing ThrowableProjectileIndicatorClass"), 30.0f);
 		UE_LOG(LogTemp, Error, TEXT("PlayerCharacter: Missing ThrowableProjectileIndicatorClass"));
@@ -180,6 +176,7 @@ void APlayerCharacter::BeginPlay()
 		PlayerWidget = CreateWidget<UPlayerWidget>(GetWorld(), PlayerWidgetClass);
 		if (PlayerWidget)
 		{
+			PlayerWidget->SetHudModel(HudModel);
 			PlayerWidget->AddToViewport();
 			PlayerWidget->ToggleStamina(true);
 		}
@@ -196,68 +193,23 @@ void APlayerCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// If player is sprinting, drain it XD
-	if (SprintMovementComponent->IsSprinting())
-	{
-		CurrentStamina = FMath::Max(0.0f, CurrentStamina - (StaminaDrainPerSec * DeltaTime));
-		if (CurrentStamina <= 0.0f) 
-			UnSprint();
-	}
-	else if (!GetCharacterMovement()->IsFalling()) // Regen the stamina only when player is on ground
-	{
-		CurrentStamina = FMath::Min(TotalStamina, CurrentStamina + (StaminaDrainPerSec * DeltaTime));
-	}
-
-	// Make sure to run the zoom in timeline
-	if (ZoomInTimeline)
-	{
-		ZoomInTimeline->TickComponent(DeltaTime, ELevelTick::LEVELTICK_TimeOnly, nullptr);
-	}
-
-	// Do the interaction tick
-	InteractionTick(DeltaTime);
-
 	// Calculate the projectile prediction and update the projectile spline 
 	// if it should be shown
 	if (ThrowableProjectilIndicator &&
 		bShowingProjectileIndicator)
 	{
-		FVector pathStartPosition = ThrowableSpawnPoint->GetComponentLocation();
 		CurrentThrowableLaunchVelocity =
 			ThrowingStrength * FollowCamera->GetForwardVector().RotateAngleAxis(
 				ThrowingAngle, FollowCamera->GetRightVector());
-		float projectileRadius = 10.0f;
-		TArray<AActor*> actorsToIgnore;
-		actorsToIgnore.Add(this);
-
-		FPredictProjectilePathResult predictResult;
-		FPredictProjectilePathParams predictParam;
-		predictParam.StartLocation = pathStartPosition;
-		predictParam.LaunchVelocity = CurrentThrowableLaunchVelocity;
-		predictParam.bTraceComplex = true;
-		predictParam.ProjectileRadius = projectileRadius;
-		predictParam.ObjectTypes = ThrowablePrecdictObjectType;
-		predictParam.bTraceComplex = false;
-		predictParam.ActorsToIgnore = actorsToIgnore;
-		predictParam.DrawDebugType = EDrawDebugTrace::Type::None;
-		predictParam.SimFrequency = 15.0f;
-		predictParam.MaxSimTime = 2.0f;
-		predictParam.bTraceWithChannel = true;
-		predictParam.bTraceWithCollision = true;
-		predictParam.ObjectTypes = ObjectTypes;
-		predictParam.TraceChannel = ECollisionChannel::ECC_Visibility;
-		predictParam.OverrideGravityZ = ThrowableGravityOverwrite;
-		UGameplayStatics::PredictProjectilePath(this, predictParam, predictResult);
-
-		// Only do the update when there are some data in
-		if (predictResult.PathData.Num() > 0)
+
+		// Only update the indicator when the prediction actually changed
+		if (ThrowTrajectoryComponent->UpdatePrediction(
+			ThrowableSpawnPoint->GetComponentLocation(),
+			CurrentThrowableLaunchVelocity,
+			ThrowableGravityOverwrite,
+			this))
 		{
-			TArray<FVector> pathLocations;
-			for (FPredictProjectilePathPointData data : predictResult.PathData)
-			{
-				pathLocations.Add(data.Location);
-			}
-			ThrowableProjectilIndicator->UpdateIndicatorLine(pathLocations);
+			ThrowableProjectilIndicator->UpdateIndicatorLine(ThrowTrajectoryComponent->GetPredictedPath());
 		}
 	}
 }
@@ -314,7 +266,7 @@ void APlayerCharacter::LookUpAtRate(float Rate)
 void APlayerCharacter::Sprint()
 {
 	if (bAllowMovementInput && 
-		CurrentStamina >= TotalStamina && // Only sprint player has full stamina
+		GetCurrentStamina() >= TotalStamina && // Only sprint player has full stamina
 		!bHHUSecondaryActive&& // Cant sprint while aiming lol
 		!GetCharacterMovement()->IsCrouching()) // Cant sprint while crouch
 	{
@@ -329,14 +281,60 @@ void APlayerCharacter::UnSprint()
 
 void APlayerCharacter::OnSprintBegin()
 {
-	FollowCamera->SetFieldOfView(PlayerDefaultValues.CameraFOV + 2.5f);
-	SprintingPostProcess->bEnabled = true;
+	CameraEffectsComponent->SetLayerActive(ECameraEffectLayer::SprintFov, true);
+	UpdateStaminaRate();
 }
 
 void APlayerCharacter::OnSprintEnd()
 {
-	FollowCamera->SetFieldOfView(PlayerDefaultValues.CameraFOV);
-	SprintingPostProcess->bEnabled = false;
+	CameraEffectsComponent->SetLayerActive(ECameraEffectLayer::SprintFov, false);
+	UpdateStaminaRate();
+}
+
+void APlayerCharacter::UpdateStaminaRate()
+{
+	// Bake the stamina gained or lost so far before changing the rate
+	CurrentStamina = GetCurrentStamina();
+	StaminaChangeTime = GetWorld()->GetTimeSeconds();
+
+	// If player is sprinting, drain it XD
+	// Regen the stamina only when player is on ground
+	if (SprintMovementComponent->IsSprinting())
+		StaminaRate = -StaminaDrainPerSec;
+	else if (!GetCharacterMovement()->IsFalling())
+		StaminaRate = StaminaDrainPerSec;
+	else
+		StaminaRate = 0.0f;
+
+	// The hud evaluates the stamina from the rate, it only has to know when the rate changes
+	if (HudModel)
+		HudModel->SetStamina(CurrentStamina, StaminaRate, StaminaChangeTime, TotalStamina);
+
+	// One timer for when the stamina runs out, instead of checking it every frame
+	FTimerManager& timerManager = GetWorld()->GetTimerManager();
+	timerManager.ClearTimer(StaminaExhaustedTimerHandle);
+	if (StaminaRate < 0.0f)
+	{
+		const float timeToExhaust = CurrentStamina / -StaminaRate;
+		if (timeToExhaust > 0.0f)
+			timerManager.SetTimer(StaminaExhaustedTimerHandle, this, &APlayerCharacter::OnStaminaExhausted, timeToExhaust, false);
+		else
+			OnStaminaExhausted();
+	}
+}
+
+void APlayerCharacter::OnStaminaExhausted()
+{
+	UnSprint();
+}
+
+void APlayerCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
+
+	// Falling pauses the regen, landing resumes it
+	if (GetWorld())
+		UpdateStaminaRate();
 }
 
 void APlayerCharacter::CrouchBegin()
@@ -345,7 +343,7 @@ void APlayerCharacter::CrouchBegin()
 		bForceCrouch)
 	{
 		Crouch();
-		HidingPostProcess->bEnabled = true;
+		CameraEffectsComponent->SetLayerActive(ECameraEffectLayer::Hiding, true);
 
 		HHUSecondaryActionEnd();
 		if (SprintMovementComponent->IsSprinting())
@@ -358,7 +356,7 @@ void APlayerCharacter::CrouchEnd()
 	if (!bForceCrouch)
 	{
 		UnCrouch();
-		HidingPostProcess->bEnabled = false;
+		CameraEffectsComponent->SetLayerActive(ECameraEffectLayer::Hiding, false);
 	}
 }
 
@@ -399,14 +397,10 @@ void APlayerCharacter::MoveForward(float Value)
 		}
 		case EPlayerMovementSet::CAVECHASE:
 		{
-			if (ACatastropheMainGameMode* mainGameMode = ACatastropheMainGameMode::GetGameModeInst(this))
+			// The track camera direction is resolved once per frame by the view context
+			if (UViewContextSubsystem* viewContextSystem = UViewContextSubsystem::GetInst(this))
 			{
-				if (ACaveCameraTrack* caveCameraTrack = mainGameMode->GetCaveCameraTrack())
-				{
-					FVector trackCameraLocation = caveCameraTrack->GetTrackFollowCamera()->GetComponentLocation();
-					Rotation = UKismetMathLibrary::FindLookAtRotation(trackCameraLocation, GetActorLocation());
-					YawRotation = FRotator(0, Rotation.Yaw, 0);
-				}
+				YawRotation = FRotator(0, viewContextSystem->GetViewContext().CaveChaseMovementYaw, 0);
 			}
 			break;
 		}
@@ -438,14 +432,10 @@ void APlayerCharacter::MoveRight(float Value)
 		}
 		case EPlayerMovementSet::CAVECHASE:
 		{
-			if (ACatastropheMainGameMode* mainGameMode = ACatastropheMainGameMode::GetGameModeInst(this))
+			// The track camera direction is resolved once per frame by the view context
+			if (UViewContextSubsystem* viewContextSystem = UViewContextSubsystem::GetInst(this))
 			{
-				if (ACaveCameraTrack* caveCameraTrack = mainGameMode->GetCaveCameraTrack())
-				{
-					FVector trackCameraLocation = caveCameraTrack->GetTrackFollowCamera()->GetComponentLocation();
-					Rotation = UKismetMathLibrary::FindLookAtRotation(trackCameraLocation, GetActorLocation());
-					YawRotation = FRotator(0, Rotation.Yaw, 0);
-				}
+				YawRotation = FRotator(0, viewContextSystem->GetViewContext().CaveChaseMovementYaw, 0);
 			}
 			break;
 		}
@@ -488,44 +478,21 @@ void APlayerCharacter::PlayerLookUp(float _value)
 	}
 }
 
-void APlayerCharacter::TimelineSetCameraZoomValue(float _alpha)
-{
-	float resultLength =
-		FMath::Lerp(
-			PlayerDefaultValues.CameraArmLength, 
-			PlayerDefaultValues.CameraArmLength * CameraZoomMultiplier, _alpha);
-	CameraBoom->TargetArmLength = resultLength;
-}
-
 void APlayerCharacter::InteractBegin()
 {
 	if (IsValid(InteractingTargetComponent) &&
 		InteractingTargetComponent->bCanInteract)
 	{
 		bInteracting = true; // Set the holding interaction begin
-		InteractingTargetComponent->Interact(this, InteractionTimeHold);
+		InteractingTargetComponent->Interact(this);
 	}
 }
 
 void APlayerCharacter::InteractEnd()
 {
 	bInteracting = false;
-	InteractionTimeHold = 0.0f;
-}
-
-void APlayerCharacter::InteractionTick(float _deltaTime)
-{
-	if (bInteracting && 
-		IsValid(InteractingTargetComponent))
-	{
-		InteractionTimeHold += _deltaTime;
-		InteractingTargetComponent->Interact(this, InteractionTimeHold);
-	}
-	else if (!bInteracting &&
-		IsValid(InteractingTargetComponent))
-	{
+	if (IsValid(InteractingTargetComponent))
 		InteractingTargetComponent->StopInteract();
-	}
 }
 
 void APlayerCharacter::HHUPrimaryActionBegin()
@@ -558,7 +525,7 @@ void APlayerCharacter::HHUSecondaryActionBegin()
 	// If cannot use HHU, just don't then
 	if (!bCanUseHHU ||
 		!IsValid(InventoryComponent) ||
-		!IsValid(ThrowableProjectilIndicator)) return;
+		!SpawnProjectileIndicator()) return;
 
 	AItemSack* currentSack = InventoryComponent->GetCurrentItemSack();
 	if (currentSack &&
@@ -575,7 +542,10 @@ void APlayerCharacter::HHUSecondaryActionBegin()
 		CameraBoom->bEnableCameraLag = false;
 		PlayerAnimInstance->bAiming = true;
 		bShowingProjectileIndicator = true;
+		CameraEffectsComponent->SetLayerActive(ECameraEffectLayer::AimZoom, true);
 
+		// Start the aim with a fresh prediction
+		ThrowTrajectoryComponent->InvalidatePrediction();
 		ThrowableProjectilIndicator->SetIndicatorEnabled(true);
 		ACatastropheMainGameMode::GetGameModeInst(this)->OnPlayerAimingBegin.Broadcast();
 	}
@@ -591,6 +561,7 @@ void APlayerCharacter::HHUSecondaryActionEnd()
 		CameraBoom->bEnableCameraLag = true;
 		PlayerAnimInstance->bAiming = false;
 		bShowingProjectileIndicator = false;
+		CameraEffectsComponent->SetLayerActive(ECameraEffectLayer::AimZoom, false);
 
 		if (ThrowableProjectilIndicator)
 			ThrowableProjectilIndicator->SetIndicatorEnabled(false);
@@ -601,6 +572,24 @@ void APlayerCharacter::HHUSecondaryActionEnd()
 	}
 }
 
+bool APlayerCharacter::SpawnProjectileIndicator()
+{
+	if (IsValid(ThrowableProjectilIndicator))
+		return true;
+
+	if (!ThrowableProjectilIndicatorClass)
+		return false;
+
+	FActorSpawnParameters spawnParam;
+	spawnParam.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ThrowableProjectilIndicator =
+		GetWorld()->SpawnActor<AThrowableProjectileIndicator>(
+			ThrowableProjectilIndicatorClass, 
+			FTransform::Identity,
+			spawnParam);
+	return IsValid(ThrowableProjectilIndicator);
+}
+
 // Call to throw a smoke bomb onto the ground
 void APlayerCharacter::ThrowSmokeBomb()
 {
@@ -639,7 +628,7 @@ void APlayerCharacter::ResetInteractionAction()
 void APlayerCharacter::ResetPlayerCharacter()
 {
 	PlayerAnimInstance->ResetAnimationValues();
-	CurrentStamina = TotalStamina;
+	SetStamina(TotalStamina);
 	bInteracting = false;
 	ToggleSpottedAlert(false);
 
@@ -653,6 +642,16 @@ void APlayerCharacter::ResetPlayerCharacter()
 void APlayerCharacter::SetStamina(float _value)
 {
 	CurrentStamina = FMath::Min(_value, TotalStamina);
+	StaminaChangeTime = GetWorld()->GetTimeSeconds();
+
+	// Reschedule the exhaustion with the new value
+	UpdateStaminaRate();
+}
+
+float APlayerCharacter::GetCurrentStamina() const
+{
+	const float elapsedTime = GetWorld()->GetTimeSeconds() - StaminaChangeTime;
+	return FMath::Clamp(CurrentStamina + (StaminaRate * elapsedTime), 0.0f, TotalStamina);
 }
 
 void APlayerCharacter::SetMovementActionEnable(bool _bEnable)
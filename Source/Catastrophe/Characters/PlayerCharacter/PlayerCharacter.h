@@ -80,8 +80,9 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
 	class USceneComponent* CamFocusPoint;
 
-	UPROPERTY(BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
-	class UTimelineComponent* ZoomInTimeline;
+	/** Blends the aim zoom, sprint fov and hiding effects of the camera */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
+	class UCameraEffectsComponent* CameraEffectsComponent;
 
 	/** Where the camera is going to be focused on during aiming */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
@@ -100,6 +101,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "HHU | Throwable", meta = (AllowPrivateAccess = "true"))
 	class USceneComponent* ThrowableSpawnPoint;
 
+	/** Predicts the path of the throwable items during aiming */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "HHU | Throwable", meta = (AllowPrivateAccess = "true"))
+	class UThrowTrajectoryComponent* ThrowTrajectoryComponent;
+
 	// The anchor of the interactable UI
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI", meta = (AllowPrivateAccess = "true"))
 	class USceneComponent* WorldUiAnchor;
@@ -134,6 +139,10 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Player | General")
 	TSubclassOf<UPlayerWidget> PlayerWidgetClass;
 
+	/** The data the HUD displays, gameplay writes into it instead of updating the widget directly */
+	UPROPERTY(BlueprintReadOnly, Category = "Player | General")
+	class UPlayerHudModel* HudModel;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player | General")
 	class UQuestWidget* QuestWidget;
 
@@ -164,9 +173,6 @@ protected:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "Interaction")
 	bool bInteracting = false;
 
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Interaction")
-	float InteractionTimeHold = 0.0f;
-
 	/** Is HHU(Hand Hold Utility) primary action active */
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "HHU | General")
 	bool bHHUPrimaryActive = false;
@@ -175,16 +181,13 @@ protected:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "HHU | General")
 	bool bHHUSecondaryActive = false;
 
-	/** The HHU zoom curve */
+	/** The HHU zoom curve, used as the blend curve of the aim zoom camera layer */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "HHU | General")
 	class UCurveFloat* ZoomInCurve;
 
+	/** The camera arm length multiplier of the aim zoom camera layer */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "HHU | General")
-	float CameraZoomMultiplier;
-
-	/** The obejct types that use during the projectile path prediction */
-	UPROPERTY(EditDefaultsOnly, Category = "HHU | Throwable")
-	TArray<TEnumAsByte<EObjectTypeQuery>> ThrowablePrecdictObjectType;
+	float CameraZoomMultiplier = 1.0f;
 
 	/** Class object that define what object will be throw out as tomato */
 	UPROPERTY(EditDefaultsOnly, Category = "HHU | Throwable")
@@ -193,9 +196,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "HHU | Throwable")
 	TSubclassOf<class AThrowableProjectileIndicator> ThrowableProjectilIndicatorClass;
 
-	UPROPERTY(EditDefaultsOnly, Category = "HHU | Throwable")
-	TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
-
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "HHU | Throwable")
 	bool bShowingProjectileIndicator;
 
@@ -222,9 +222,22 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Movement")
 	float StaminaDrainPerSec = 10.0f;
 
-	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "Movement")
+	/**
+	 * The stamina at StaminaChangeTime, use GetCurrentStamina to get the stamina of now
+	 * Blueprints reading it get the stamina of now through the getter
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintGetter = GetCurrentStamina, BlueprintSetter = SetStamina, Category = "Movement")
 	float CurrentStamina;
 
+	/** World time when the stamina or its rate has last changed */
+	float StaminaChangeTime = 0.0f;
+
+	/** Stamina change per second since StaminaChangeTime, negative while sprinting */
+	float StaminaRate = 0.0f;
+
+	/** Timer handle that stops the sprint when the stamina runs out */
+	FTimerHandle StaminaExhaustedTimerHandle;
+
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadWrite, Category = "Movement")
 	bool bSprinting = false;
 
@@ -315,6 +328,19 @@ protected:
 	UFUNCTION()
 	void OnSprintEnd();
 
+	/**
+	 * Stores the stamina of now and sets the new rate depending on the sprint and falling state
+	 * @author Richard Wulansari
+	 * @note Called whenever the sprint or the movement mode changes, the stamina is not ticked
+	 */
+	void UpdateStaminaRate();
+
+	/** Called by timer when the stamina runs out during sprint */
+	void OnStaminaExhausted();
+
+	/** Called when the movement mode has changed, e.g. landing */
+	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
+
 	/** Called for character crouching begin */
 	void CrouchBegin();
 
@@ -327,9 +353,6 @@ protected:
 	/** Called when the interaction button released */
 	void InteractEnd();
 
-	/** Called each tick to do interaction stuff */
-	void InteractionTick(float _deltaTime);
-
 	/** HHD(Hand Hold Utility) primary action begin */
 	void HHUPrimaryActionBegin();
 
@@ -342,11 +365,14 @@ protected:
 	/** HHD(Hand Hold Utility) secondary action end */
 	void HHUSecondaryActionEnd();
 
-#pragma endregion Controller Action
+	/**
+	 * Spawns the projectile indicator if it does not exist yet
+	 * @author Richard Wulansari
+	 * @return False if the indicator could not be spawned
+	 */
+	bool SpawnProjectileIndicator();
 
-	/** Called when ZoomInTimeline ticks */
-	UFUNCTION()
-	void TimelineSetCameraZoomValue(float _alpha);
+#pragma endregion Controller Action
 
 	/**
 	 * Called when player throw a smoke bomb
@@ -422,6 +448,13 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Movement")
 	void SetStamina(float _value);
+
+	/**
+	 * Gets the stamina of now, evaluated from the last change and the rate
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION(BlueprintPure, Category = "Movement")
+	float GetCurrentStamina() const;
 	
 	/**
 	 * Called to set if player can control the character movemement related action or not
@@ -479,6 +512,7 @@ public:
 	FORCEINLINE class UAIPerceptionStimuliSourceComponent* GetStimulusSourceComponent() const { return PerceptionStimuliSourceComponent; }
 	FORCEINLINE float GetTotalStamina() const { return TotalStamina; }
 	FORCEINLINE class UPlayerWidget* GetPlayerHudWidget() const { return PlayerWidget; }
+	FORCEINLINE class UPlayerHudModel* GetHudModel() const { return HudModel; }
 	FORCEINLINE class UQuestWidget* GetQuestWidget() const { return QuestWidget; }
 	FORCEINLINE class UCameraComponent* GetCamera() const { return FollowCamera; }
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
@@ -492,6 +526,7 @@ public:
 	FORCEINLINE FVector GetCurrentThrowingVelocity() const { return CurrentThrowableLaunchVelocity; }
 	FORCEINLINE float GetThrowingGravity() const { return ThrowableGravityOverwrite; }
 	FORCEINLINE class UInteractableComponent* GetInteractingTargetComponent() const { return InteractingTargetComponent; }
+	FORCEINLINE bool IsInteracting() const { return bInteracting; }
 	/** Getter End */
 
 };
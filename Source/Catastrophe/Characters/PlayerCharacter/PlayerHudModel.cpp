@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PlayerHudModel.h"
+
+#include "Interactable/BaseClasses/InteractableComponent.h"
+#include "UtilitySacks/ItemSack.h"
+
+void UPlayerHudModel::SetInteraction(UInteractableComponent* _interactable, bool _bVisible)
+{
+	if (InteractionTarget.Get() == _interactable && bInteractionUiVisible == _bVisible)
+		return;
+
+	InteractionTarget = _interactable;
+	bInteractionUiVisible = _bVisible;
+	DirtySections |= EHudSection::Interaction;
+}
+
+void UPlayerHudModel::SetStamina(float _anchor, float _rate, float _changeTime, float _total)
+{
+	// Only a change of the rate is a change of the curve, the anchor moves along it
+	if (StaminaRate == _rate &&
+		TotalStamina == _total &&
+		FMath::IsNearlyEqual(GetStaminaAt(_changeTime), _anchor))
+	{
+		return;
+	}
+
+	StaminaAnchor = _anchor;
+	StaminaRate = _rate;
+	StaminaChangeTime = _changeTime;
+	TotalStamina = _total;
+	DirtySections |= EHudSection::Stamina;
+}
+
+void UPlayerHudModel::SetCurrentItem(AItemSack* _itemSack, int32 _amount)
+{
+	if (CurrentItemSack.Get() == _itemSack && CurrentItemAmount == _amount)
+		return;
+
+	CurrentItemSack = _itemSack;
+	CurrentItemAmount = _amount;
+	DirtySections |= EHudSection::Inventory;
+}
+
+void UPlayerHudModel::SetQuestText(const FString& _questText)
+{
+	if (QuestText.Equals(_questText, ESearchCase::CaseSensitive))
+		return;
+
+	QuestText = _questText;
+	DirtySections |= EHudSection::Quest;
+}
+
+EHudSection UPlayerHudModel::ConsumeDirtySections()
+{
+	const EHudSection dirtySections = DirtySections;
+	DirtySections = EHudSection::None;
+	return dirtySections;
+}
+
+float UPlayerHudModel::GetStaminaAt(float _worldTime) const
+{
+	const float elapsedTime = _worldTime - StaminaChangeTime;
+	return FMath::Clamp(StaminaAnchor + (StaminaRate * elapsedTime), 0.0f, TotalStamina);
+}
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "PlayerHudModel.generated.h"
+
+/** The sections of the player HUD that can be refreshed independently */
+enum class EHudSection : uint8
+{
+	None		= 0,
+	Interaction	= 1 << 0,
+	Stamina		= 1 << 1,
+	Inventory	= 1 << 2,
+	Quest		= 1 << 3,
+	All			= Interaction | Stamina | Inventory | Quest
+};
+ENUM_CLASS_FLAGS(EHudSection)
+
+/**
+ * This holds everything the player HUD displays
+ * Gameplay writes into it when a value changes, each write marks its section dirty
+ * The player widget consumes the dirty sections once per frame, unchanged sections are not touched
+ */
+UCLASS(BlueprintType)
+class CATASTROPHE_API UPlayerHudModel : public UObject
+{
+	GENERATED_BODY()
+
+private:
+
+	/** The sections that has changed since the widget last consumed them */
+	EHudSection DirtySections = EHudSection::All;
+
+	/** The interactable the interaction ui is showing */
+	TWeakObjectPtr<class UInteractableComponent> InteractionTarget;
+
+	bool bInteractionUiVisible = false;
+
+	/** The stamina at StaminaChangeTime, the current value is evaluated from the rate */
+	float StaminaAnchor = 0.0f;
+
+	/** Stamina change per second since StaminaChangeTime */
+	float StaminaRate = 0.0f;
+
+	float StaminaChangeTime = 0.0f;
+
+	float TotalStamina = 100.0f;
+
+	/** The currently selected item sack */
+	TWeakObjectPtr<class AItemSack> CurrentItemSack;
+
+	int32 CurrentItemAmount = 0;
+
+	/** The current objective text */
+	FString QuestText;
+
+public:
+
+	/**
+	 * Sets the interaction target and the visibility of the interaction ui
+	 * @author Richard Wulansari
+	 * @param _interactable The interactable that holds the info, can be null when hiding
+	 * @param _bVisible Should the interaction ui be shown
+	 */
+	void SetInteraction(class UInteractableComponent* _interactable, bool _bVisible);
+
+	/**
+	 * Sets the stamina values, the widget interpolates the value between changes
+	 * @author Richard Wulansari
+	 * @param _anchor The stamina at _changeTime
+	 * @param _rate Stamina change per second
+	 * @param _changeTime World time when the anchor was taken
+	 * @param _total The maximum stamina
+	 */
+	void SetStamina(float _anchor, float _rate, float _changeTime, float _total);
+
+	/**
+	 * Sets the currently selected item sack and how many items it holds
+	 * @author Richard Wulansari
+	 * @param _itemSack Can be null if the inventory is empty
+	 * @param _amount
+	 */
+	void SetCurrentItem(class AItemSack* _itemSack, int32 _amount);
+
+	/**
+	 * Sets the text of the current quest objective
+	 * @author Richard Wulansari
+	 * @param _questText
+	 */
+	void SetQuestText(const FString& _questText);
+
+	/**
+	 * Forces a section to refresh without any value change, e.g. a hold interaction has started
+	 * @author Richard Wulansari
+	 * @param _section
+	 */
+	FORCEINLINE void MarkDirty(EHudSection _section) { DirtySections |= _section; }
+
+	/**
+	 * Gets the dirty sections and clears them, called once per frame by the widget
+	 * @author Richard Wulansari
+	 */
+	EHudSection ConsumeDirtySections();
+
+	/**
+	 * Gets the stamina at a world time, used by the widget to interpolate the stamina between changes
+	 * @author Richard Wulansari
+	 * @param _worldTime
+	 */
+	UFUNCTION(BlueprintPure, Category = "HudModel")
+	float GetStaminaAt(float _worldTime) const;
+
+	/** Getter */
+	FORCEINLINE class UInteractableComponent* GetInteractionTarget() const { return InteractionTarget.Get(); }
+	FORCEINLINE bool IsInteractionUiVisible() const { return bInteractionUiVisible; }
+	FORCEINLINE float GetStaminaAnchor() const { return StaminaAnchor; }
+	FORCEINLINE float GetStaminaRate() const { return StaminaRate; }
+	FORCEINLINE float GetStaminaChangeTime() const { return StaminaChangeTime; }
+	FORCEINLINE float GetTotalStamina() const { return TotalStamina; }
+	FORCEINLINE class AItemSack* GetCurrentItemSack() const { return CurrentItemSack.Get(); }
+	FORCEINLINE int32 GetCurrentItemAmount() const { return CurrentItemAmount; }
+	FORCEINLINE const FString& GetQuestText() const { return QuestText; }
+	/** Getter End */
+
+};
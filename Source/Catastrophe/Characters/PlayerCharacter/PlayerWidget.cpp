@@ -4,8 +4,12 @@
 #include "PlayerWidget.h"
 
 #include "Runtime/UMG/Public/Components/CanvasPanel.h"
+#include "Runtime/UMG/Public/Components/InvalidationBox.h"
+#include "Engine/World.h"
 
 #include "Gameplay/QTE_Bob/QteBobWidget.h"
+#include "Interactable/BaseClasses/InteractableComponent.h"
+#include "PlayerHudModel.h"
 
 UPlayerWidget::UPlayerWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -20,6 +24,69 @@ void UPlayerWidget::NativeConstruct()
 
 }
 
+void UPlayerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (!HudModel) return;
+
+	const EHudSection dirtySections = HudModel->ConsumeDirtySections();
+
+	// The hold progress is interpolated by the blueprint with GetHoldProgress, only the start and the end of a hold are pushed
+	if (EnumHasAnyFlags(dirtySections, EHudSection::Interaction))
+	{
+		UInteractableComponent* interactionTarget = HudModel->GetInteractionTarget();
+		const bool bVisible = HudModel->IsInteractionUiVisible();
+		if (IsValid(interactionTarget))
+			UpdateInteractionUi(interactionTarget);
+		SetInteractionUiVisible(bVisible);
+		OnHudInteractionChanged(interactionTarget, bVisible);
+
+		// The progress bar moves every frame during a hold, so the section can't be cached meanwhile
+		if (InteractionSection)
+		{
+			InteractionSection->SetCanCache(!IsValid(interactionTarget) || !interactionTarget->IsInteracting());
+			InteractionSection->InvalidateCache();
+		}
+	}
+
+	// The stamina is interpolated by the blueprint with GetStaminaAt, only a new rate or anchor is pushed
+	if (EnumHasAnyFlags(dirtySections, EHudSection::Stamina))
+	{
+		OnHudStaminaChanged(HudModel->GetStaminaAnchor(), HudModel->GetStaminaRate(), HudModel->GetStaminaChangeTime(), HudModel->GetTotalStamina());
+
+		if (StaminaSection)
+		{
+			StaminaSection->SetCanCache(HudModel->GetStaminaRate() == 0.0f);
+			StaminaSection->InvalidateCache();
+		}
+	}
+
+	if (EnumHasAnyFlags(dirtySections, EHudSection::Inventory))
+	{
+		OnHudInventoryChanged(HudModel->GetCurrentItemSack(), HudModel->GetCurrentItemAmount());
+
+		if (InventorySection)
+			InventorySection->InvalidateCache();
+	}
+
+	if (EnumHasAnyFlags(dirtySections, EHudSection::Quest))
+	{
+		OnHudQuestChanged(HudModel->GetQuestText());
+
+		if (QuestSection)
+			QuestSection->InvalidateCache();
+	}
+}
+
+void UPlayerWidget::SetHudModel(UPlayerHudModel* _hudModel)
+{
+	HudModel = _hudModel;
+
+	if (HudModel)
+		HudModel->MarkDirty(EHudSection::All);
+}
+
 void UPlayerWidget::ToggleCrosshair_Implementation(bool _bEnable)
 {
 	/// Let blueprint do the thing
@@ -25,12 +25,78 @@ protected:
 	UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
 	class UCanvasPanel* MainCanvasPanel;
 
+	/** Optional cached panels of each HUD section, they are only invalidated when their section changes */
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	class UInvalidationBox* InteractionSection;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	class UInvalidationBox* StaminaSection;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	class UInvalidationBox* InventorySection;
+
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	class UInvalidationBox* QuestSection;
+
+	/** The data this HUD displays, written by gameplay */
+	UPROPERTY(BlueprintReadOnly, Category = "PlayerWidget")
+	class UPlayerHudModel* HudModel;
+
 protected:
 
 	virtual void NativeConstruct() override;
 
+	/** Consumes the dirty sections of the HUD model */
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
 public:
 
+	/**
+	 * Sets the model this HUD displays, all sections will be refreshed
+	 * @author Richard Wulansari
+	 * @param _hudModel
+	 */
+	void SetHudModel(class UPlayerHudModel* _hudModel);
+
+	/**
+	 * Called when the interaction target or its visibility has changed, and when a hold starts or ends
+	 * The hold progress is not pushed, read it with GetHoldProgress on the target
+	 * @author Richard Wulansari
+	 * @param _interactableComp The interactable component that holds all the info, can be null
+	 * @param _bVisible Should the interaction ui be shown
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "PlayerWidget | HudModel")
+	void OnHudInteractionChanged(class UInteractableComponent* _interactableComp, bool _bVisible);
+
+	/**
+	 * Called when the stamina rate or anchor has changed, not while the stamina moves along the rate
+	 * The current stamina is read with GetStaminaAt on the HUD model
+	 * @author Richard Wulansari
+	 * @param _anchor The stamina at _changeTime
+	 * @param _rate Stamina change per second
+	 * @param _changeTime World time when the anchor was taken
+	 * @param _total The maximum stamina
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "PlayerWidget | HudModel")
+	void OnHudStaminaChanged(float _anchor, float _rate, float _changeTime, float _total);
+
+	/**
+	 * Called when the selected item sack or its amount has changed
+	 * @author Richard Wulansari
+	 * @param _itemSack The selected item sack, can be null
+	 * @param _amount The amount of items in the sack
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "PlayerWidget | HudModel")
+	void OnHudInventoryChanged(class AItemSack* _itemSack, int32 _amount);
+
+	/**
+	 * Called when the quest objective text has changed
+	 * @author Richard Wulansari
+	 * @param _questText
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "PlayerWidget | HudModel")
+	void OnHudQuestChanged(const FString& _questText);
+
 	/**
 	 * Called to toggle crosshair visibility
 	 * @author Richard Wulansari
@@ -62,6 +128,7 @@ public:
 	 * Set the visibility of the interaction ui
 	 * @author Richard Wulansari
 	 * @param _visibility
+	 * @note Called by the HUD model pipeline, gameplay should write into the HUD model instead
 	 */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "PlayerWidget | Interaction")
 	void SetInteractionUiVisible(bool _visibility);
@@ -70,6 +137,7 @@ public:
 	 * Update the interaction ui
 	 * @author Richard Wulansari
 	 * @param _interactableComp The interactable component that holds all the info
+	 * @note Called by the HUD model pipeline, gameplay should write into the HUD model instead
 	 */
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "PlayerWidget | Interaction")
 	void UpdateInteractionUi(class UInteractableComponent* _interactableComp);
@@ -84,5 +152,8 @@ public:
 	class UQteBobWidget* CreateQteBobWidget(class AQteBobLogicHolder* _qteLogicHolder);
 	class UQteBobWidget* CreateQteBobWidget_Implementation(class AQteBobLogicHolder* _qteLogicHolder);
 
+	/** Getter */
+	FORCEINLINE class UPlayerHudModel* GetHudModel() const { return HudModel; }
+	/** Getter End */
 
 };
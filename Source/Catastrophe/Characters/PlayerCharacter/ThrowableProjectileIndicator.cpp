@@ -3,20 +3,23 @@
 
 #include "ThrowableProjectileIndicator.h"
 
-#include "Components/SplineComponent.h"
-#include "Components/SplineMeshComponent.h"
-#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "ProceduralMeshComponent.h"
 
 // Sets default values
 AThrowableProjectileIndicator::AThrowableProjectileIndicator()
 {
- 	// Set this actor to call Tick() every frame
-	PrimaryActorTick.bCanEverTick = true;
+ 	// The ribbon is only updated when a new path comes in
+	PrimaryActorTick.bCanEverTick = false;
 
 	SetActorHiddenInGame(true);
 
-	SplineComponent = CreateDefaultSubobject<USplineComponent>(TEXT("SplineComponent"));
-	RootComponent = SplineComponent;
+	RibbonMesh = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("RibbonMesh"));
+	RibbonMesh->bUseAsyncCooking = false;
+	RibbonMesh->SetGenerateOverlapEvents(false);
+	RibbonMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RibbonMesh->SetCastShadow(false);
+	RootComponent = RibbonMesh;
 
 	EndpointMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("EndpointMesh"));
 	EndpointMesh->SetGenerateOverlapEvents(false);
@@ -29,57 +32,73 @@ void AThrowableProjectileIndicator::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Initiate all the spline segment mesh components
-	for (int32 i = 0; i < NumberOfMeshSegments; ++i)
-	{
-		USplineMeshComponent* splineMesh = NewObject<USplineMeshComponent>(this);
-		splineMesh->RegisterComponent();
-		splineMesh->SetMobility(EComponentMobility::Movable);
-		splineMesh->SetForwardAxis(ESplineMeshAxis::X);
-		splineMesh->SetStaticMesh(IndicatorMesh);
-		splineMesh->SetMaterial(0, IndicatorMaterial);
-		splineMesh->SetGenerateOverlapEvents(false);
-		splineMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-		splineMesh->SetCastShadow(false);	
-		splineMesh->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
-		SplineMeshes.Add(splineMesh);
-	}
+	// The vertices are in world space, so the ribbon stays at the origin
+	RibbonMesh->SetWorldTransform(FTransform::Identity);
 }
 
-// Called every frame
-void AThrowableProjectileIndicator::Tick(float DeltaTime)
+// Rebuild the ribbon along the points
+void AThrowableProjectileIndicator::UpdateIndicatorLine(const TArray<FVector>& _vectors)
 {
-	Super::Tick(DeltaTime);
+	const int32 pointCount = _vectors.Num();
+	if (pointCount < 2)
+		return;
 
-	if (SplineComponent->GetNumberOfSplinePoints() > 0 &&
-		bRenderingSpline)
+	RibbonVertices.Reset(pointCount * 2);
+	RibbonNormals.Reset(pointCount * 2);
+	RibbonUVs.Reset(pointCount * 2);
+
+	// Two vertices per point, spread sideway from the path
+	float distanceAlongPath = 0.0f;
+	const float halfWidth = RibbonWidth * 0.5f;
+	for (int32 i = 0; i < pointCount; ++i)
 	{
-		float splineLength = SplineComponent->GetSplineLength();
-		float segmentLength = splineLength / NumberOfMeshSegments;
-		for (int32 i = 0; i < NumberOfMeshSegments; ++i)
-		{
-			FVector startPos = SplineComponent->GetLocationAtDistanceAlongSpline(segmentLength * i, ESplineCoordinateSpace::World);
-			FVector startTangent = SplineComponent->GetTangentAtDistanceAlongSpline(segmentLength * i, ESplineCoordinateSpace::World);
-			FVector endPos = SplineComponent->GetLocationAtDistanceAlongSpline(segmentLength * (i + 1), ESplineCoordinateSpace::World);;
-			FVector endTangent = SplineComponent->GetTangentAtDistanceAlongSpline(segmentLength * (i + 1), ESplineCoordinateSpace::World);;
+		const FVector& point = _vectors[i];
+		const FVector tangent = (_vectors[FMath::Min(i + 1, pointCount - 1)] - _vectors[FMath::Max(i - 1, 0)]).GetSafeNormal();
+		FVector side = FVector::CrossProduct(tangent, FVector::UpVector).GetSafeNormal();
+		if (side.IsNearlyZero())
+			side = FVector::RightVector;
+		const FVector normal = FVector::CrossProduct(side, tangent);
+
+		if (i > 0)
+			distanceAlongPath += FVector::Dist(_vectors[i - 1], point);
+		const float v = UVTileLength > 0.0f ? distanceAlongPath / UVTileLength : 0.0f;
+
+		RibbonVertices.Add(point - side * halfWidth);
+		RibbonVertices.Add(point + side * halfWidth);
+		RibbonNormals.Add(normal);
+		RibbonNormals.Add(normal);
+		RibbonUVs.Add(FVector2D(0.0f, v));
+		RibbonUVs.Add(FVector2D(1.0f, v));
+	}
 
-			SplineMeshes[i]->SetStartAndEnd(startPos, startTangent, endPos, endTangent);
+	// Only the vertex buffer needs an update if the topology stays the same
+	if (pointCount == RibbonPointCount)
+	{
+		RibbonMesh->UpdateMeshSection(0, RibbonVertices, RibbonNormals, RibbonUVs, TArray<FColor>(), TArray<FProcMeshTangent>());
+	}
+	else
+	{
+		RibbonTriangles.Reset((pointCount - 1) * 6);
+		for (int32 i = 0; i < pointCount - 1; ++i)
+		{
+			const int32 vertex = i * 2;
+			RibbonTriangles.Add(vertex);
+			RibbonTriangles.Add(vertex + 2);
+			RibbonTriangles.Add(vertex + 1);
+			RibbonTriangles.Add(vertex + 1);
+			RibbonTriangles.Add(vertex + 2);
+			RibbonTriangles.Add(vertex + 3);
 		}
 
-		FVector splineEnd = SplineComponent->GetLocationAtDistanceAlongSpline(splineLength, ESplineCoordinateSpace::World);
-		EndpointMesh->SetWorldLocation(splineEnd);
+		RibbonMesh->CreateMeshSection(0, RibbonVertices, RibbonTriangles, RibbonNormals, RibbonUVs, TArray<FColor>(), TArray<FProcMeshTangent>(), false);
+		RibbonMesh->SetMaterial(0, IndicatorMaterial);
+		RibbonPointCount = pointCount;
 	}
-}
 
-// Update the points in the spline
-void AThrowableProjectileIndicator::UpdateIndicatorLine(TArray<FVector> _vectors)
-{
-	SplineComponent->ClearSplinePoints(false);
-	SplineComponent->SetSplinePoints(_vectors, ESplineCoordinateSpace::World, true);
+	EndpointMesh->SetWorldLocation(_vectors.Last());
 }
 
 void AThrowableProjectileIndicator::SetIndicatorEnabled(bool _enabled)
 {
-	bRenderingSpline = _enabled;
 	SetActorHiddenInGame(!_enabled);
 }
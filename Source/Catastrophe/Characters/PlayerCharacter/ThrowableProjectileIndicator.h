@@ -6,6 +6,10 @@
 #include "GameFramework/Actor.h"
 #include "ThrowableProjectileIndicator.generated.h"
 
+/**
+ * Shows the predicted path of the throwable object as a single ribbon mesh
+ * The ribbon is only rebuilt when a new path is given, nothing is done per frame
+ */
 UCLASS()
 class CATASTROPHE_API AThrowableProjectileIndicator : public AActor
 {
@@ -13,51 +17,55 @@ class CATASTROPHE_API AThrowableProjectileIndicator : public AActor
 	
 private:
 
+	/** The ribbon that follows the path */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ProjectileIndicator", meta = (AllowPrivateAccess = "true"))
-	class USplineComponent* SplineComponent;
+	class UProceduralMeshComponent* RibbonMesh;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ProjectileIndicator", meta = (AllowPrivateAccess = "true"))
 	class UStaticMeshComponent* EndpointMesh;
 
 protected:
 
-	/** Number of segmnents to form the spline, more segment means smoother spline */
+	/** Width of the ribbon */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ProjectileIndicator")
-	int32 NumberOfMeshSegments = 30;
+	float RibbonWidth = 10.0f;
 
+	/** Length of the ribbon covered by one tile of the material along the path */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ProjectileIndicator")
-	class UStaticMesh* IndicatorMesh;
+	float UVTileLength = 100.0f;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "ProjectileIndicator")
 	class UMaterialInterface* IndicatorMaterial;
 
-	UPROPERTY(BlueprintReadWrite)
-	TArray<class USplineMeshComponent*> SplineMeshes;
-
 public:	
 	// Sets default values for this actor's properties
 	AThrowableProjectileIndicator();
 
 private:
 
-	bool bRenderingSpline = false;
+	/** Vertex buffers reused between updates */
+	TArray<FVector> RibbonVertices;
+	TArray<FVector> RibbonNormals;
+	TArray<FVector2D> RibbonUVs;
+	TArray<int32> RibbonTriangles;
+
+	/** Number of path points the current mesh section is built for */
+	int32 RibbonPointCount = 0;
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
 public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
 
 	/**
-	 * Update the spline points
+	 * Rebuild the ribbon along the points
 	 * @author Richard Wulansari
 	 * @param _vectors Array of vector points
 	 * @note Those vectors needs to be in world space coord
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ProjectileIndicator")
-	void UpdateIndicatorLine(TArray<FVector> _vectors);
+	void UpdateIndicatorLine(const TArray<FVector>& _vectors);
 
 	/**
 	 * Set the visibility of the spline indicator
@@ -68,7 +76,7 @@ public:
 	void SetIndicatorEnabled(bool _enabled);
 
 	/** Getter */
-	FORCEINLINE class USplineComponent* GetSplineComponent() const { return SplineComponent; }
+	FORCEINLINE class UProceduralMeshComponent* GetRibbonMesh() const { return RibbonMesh; }
 
 
 };
@@ -23,18 +23,18 @@ void AItemSack::AddItem()
 	if (ItemAmount < MaxItemAmount)
 	{
 		Receive_AddItem();
-		ItemAmount++;
+		SetItemAmount(ItemAmount + 1);
 	}
 }
 
 void AItemSack::AddItems(uint8 _Amount)
 {
-	ItemAmount = (uint8)FMath::Min((int32)(ItemAmount + _Amount), (int32)MaxItemAmount);
+	SetItemAmount((uint8)FMath::Min((int32)(ItemAmount + _Amount), (int32)MaxItemAmount));
 }
 
 void AItemSack::FillItemSack()
 {
-	ItemAmount = MaxItemAmount;
+	SetItemAmount(MaxItemAmount);
 }
 
 bool AItemSack::IsItemSackFull() const
@@ -46,18 +46,18 @@ void AItemSack::RemoveItem()
 {
 	if (ItemAmount > 0)
 	{
-		ItemAmount--;
+		SetItemAmount(ItemAmount - 1);
 	}
 }
 
 void AItemSack::RemoveItems(uint8 _Amount)
 {
-	ItemAmount = (uint8)FMath::Max((int32)(ItemAmount - _Amount), 0);
+	SetItemAmount((uint8)FMath::Max((int32)(ItemAmount - _Amount), 0));
 }
 
 void AItemSack::EmptyItemSack()
 {
-	ItemAmount = 0;
+	SetItemAmount(0);
 }
 
 bool AItemSack::IsItemSackEmpty() const
@@ -67,7 +67,10 @@ bool AItemSack::IsItemSackEmpty() const
 
 void AItemSack::SetItemAmount(uint8 _Amount)
 {
+	if (ItemAmount == _Amount) return;
+
 	ItemAmount = _Amount;
+	OnItemAmountChanged.Broadcast(this);
 }
 
 uint8 AItemSack::GetItemAmount() const
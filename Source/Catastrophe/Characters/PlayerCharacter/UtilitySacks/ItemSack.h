@@ -6,6 +6,9 @@
 #include "GameFramework/Actor.h"
 #include "ItemSack.generated.h"
 
+/** Delegate declaration */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FItemSackSignature, class AItemSack*, _itemSack);
+
 UCLASS()
 class CATASTROPHE_API AItemSack : public AActor
 {
@@ -32,6 +35,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ItemSack")
 	bool bCanPickup = true;
 
+	/** Called when the amount of items in the sack has changed */
+	UPROPERTY(BlueprintAssignable)
+	FItemSackSignature OnItemAmountChanged;
+
 public:	
 	// Sets default values for this actor's properties
 	AItemSack();
@@ -104,6 +111,7 @@ public:
 	/**
 	 * Called to set the amount of items that is in the sack
 	 * @author James Johnstone
+	 * @note Every change of the amount goes through this, it broadcasts OnItemAmountChanged
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ItemSack")
 	void SetItemAmount(uint8 _Amount);
@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CameraEffectsComponent.h"
+
+#include "Camera/CameraComponent.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "Components/PostProcessComponent.h"
+#include "Curves/CurveFloat.h"
+
+float FCameraEffectLayer::GetBlendLength() const
+{
+	if (BlendCurve)
+	{
+		float minTime, maxTime;
+		BlendCurve->GetTimeRange(minTime, maxTime);
+		return FMath::Max(maxTime, 0.0f);
+	}
+	return FMath::Max(BlendTime, 0.0f);
+}
+
+float FCameraEffectLayer::EvaluateWeight() const
+{
+	if (BlendCurve)
+		return BlendCurve->GetFloatValue(BlendPosition);
+
+	const float blendLength = GetBlendLength();
+	return blendLength > 0.0f ? BlendPosition / blendLength : (bActive ? 1.0f : 0.0f);
+}
+
+// Sets default values for this component's properties
+UCameraEffectsComponent::UCameraEffectsComponent()
+{
+	// Only ticks while a layer is blending
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	Layers.SetNum((int32)ECameraEffectLayer::MAX);
+	Layers[(int32)ECameraEffectLayer::SprintFov].FovOffset = 2.5f;
+	Layers[(int32)ECameraEffectLayer::SprintFov].BlendTime = 0.15f;
+	Layers[(int32)ECameraEffectLayer::Hiding].BlendTime = 0.2f;
+}
+
+void UCameraEffectsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	bool bAnyBlending = false;
+	for (FCameraEffectLayer& layer : Layers)
+	{
+		if (!layer.IsBlending())
+			continue;
+
+		const float blendLength = layer.GetBlendLength();
+		layer.BlendPosition = FMath::Clamp(
+			layer.BlendPosition + (layer.bActive ? DeltaTime : -DeltaTime), 0.0f, blendLength);
+		layer.Weight = layer.EvaluateWeight();
+		bAnyBlending |= layer.IsBlending();
+	}
+
+	ApplyLayers();
+
+	// Nothing is moving anymore, go idle until the next change
+	if (!bAnyBlending)
+		SetComponentTickEnabled(false);
+}
+
+void UCameraEffectsComponent::Initialize(UCameraComponent* _camera, USpringArmComponent* _cameraBoom, float _baseFov, float _baseArmLength)
+{
+	Camera = _camera;
+	CameraBoom = _cameraBoom;
+	BaseFov = _baseFov;
+	BaseArmLength = _baseArmLength;
+	ApplyLayers();
+}
+
+void UCameraEffectsComponent::SetLayerActive(ECameraEffectLayer _layer, bool _bActive)
+{
+	if (!Layers.IsValidIndex((int32)_layer)) return;
+
+	FCameraEffectLayer& layer = Layers[(int32)_layer];
+	if (layer.bActive == _bActive) return;
+
+	layer.bActive = _bActive;
+
+	// Layers without blend time snap, the rest blends in the tick
+	if (layer.GetBlendLength() <= 0.0f)
+	{
+		layer.BlendPosition = 0.0f;
+		layer.Weight = _bActive ? 1.0f : 0.0f;
+		ApplyLayers();
+	}
+	else
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UCameraEffectsComponent::SetLayerPostProcess(ECameraEffectLayer _layer, UPostProcessComponent* _postProcess)
+{
+	if (!Layers.IsValidIndex((int32)_layer)) return;
+
+	Layers[(int32)_layer].PostProcess = _postProcess;
+	ApplyLayers();
+}
+
+void UCameraEffectsComponent::ResetLayers()
+{
+	for (FCameraEffectLayer& layer : Layers)
+	{
+		layer.bActive = false;
+		layer.BlendPosition = 0.0f;
+		layer.Weight = 0.0f;
+	}
+
+	ApplyLayers();
+	SetComponentTickEnabled(false);
+}
+
+float UCameraEffectsComponent::GetLayerWeight(ECameraEffectLayer _layer) const
+{
+	return Layers.IsValidIndex((int32)_layer) ? Layers[(int32)_layer].Weight : 0.0f;
+}
+
+void UCameraEffectsComponent::ApplyLayers()
+{
+	float fov = BaseFov;
+	float armLength = BaseArmLength;
+	for (const FCameraEffectLayer& layer : Layers)
+	{
+		fov += layer.FovOffset * layer.Weight;
+		armLength += BaseArmLength * (layer.ArmLengthMultiplier - 1.0f) * layer.Weight;
+
+		if (layer.PostProcess)
+		{
+			layer.PostProcess->BlendWeight = layer.Weight;
+			layer.PostProcess->bEnabled = layer.Weight > 0.0f;
+		}
+	}
+
+	if (Camera)
+		Camera->SetFieldOfView(fov);
+	if (CameraBoom)
+		CameraBoom->TargetArmLength = armLength;
+}
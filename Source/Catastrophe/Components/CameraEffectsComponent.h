@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CameraEffectsComponent.generated.h"
+
+/** The camera effects that can be blended in and out */
+UENUM(BlueprintType)
+enum class ECameraEffectLayer : uint8
+{
+	AimZoom,
+	SprintFov,
+	Hiding,
+	MAX UMETA(Hidden)
+};
+
+/**
+ * One weighted camera effect, its weight follows the blend curve forward when active and backward when not
+ */
+USTRUCT(BlueprintType)
+struct FCameraEffectLayer
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Maps the blend time to the weight, the length of the curve is the blend time. Linear if null */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
+	class UCurveFloat* BlendCurve = nullptr;
+
+	/** Blend time used when there is no blend curve */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
+	float BlendTime = 0.3f;
+
+	/** The camera arm length multiplier at full weight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
+	float ArmLengthMultiplier = 1.0f;
+
+	/** Added to the camera field of view at full weight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
+	float FovOffset = 0.0f;
+
+	/** The post process that follows the weight of this layer */
+	UPROPERTY(Transient)
+	class UPostProcessComponent* PostProcess = nullptr;
+
+	bool bActive = false;
+
+	/** The position on the blend curve */
+	float BlendPosition = 0.0f;
+
+	float Weight = 0.0f;
+
+	/** Gets the length of the blend */
+	float GetBlendLength() const;
+
+	/** Gets the weight at the current blend position */
+	float EvaluateWeight() const;
+
+	/** True if the layer has not reached the end it is blending to */
+	FORCEINLINE bool IsBlending() const
+	{
+		return bActive ? BlendPosition < GetBlendLength() : BlendPosition > 0.0f;
+	}
+};
+
+/**
+ * This component blends the camera effects of the player, e.g. aim zoom and sprint fov
+ * All the layers are evaluated together once per frame, the component only ticks while a layer is blending
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class CATASTROPHE_API UCameraEffectsComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+private:
+
+	UPROPERTY()
+	class UCameraComponent* Camera;
+
+	UPROPERTY()
+	class USpringArmComponent* CameraBoom;
+
+	/** The values with no effect applied */
+	float BaseFov = 90.0f;
+	float BaseArmLength = 300.0f;
+
+public:
+	UCameraEffectsComponent();
+
+	/** The layers, indexed by ECameraEffectLayer */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Camera Effects", EditFixedSize)
+	TArray<FCameraEffectLayer> Layers;
+
+public:
+	// Called only while a layer is blending
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * Sets the camera the effects are applied to
+	 * @author Richard Wulansari
+	 * @param _camera
+	 * @param _cameraBoom
+	 * @param _baseFov The field of view with no effect
+	 * @param _baseArmLength The arm length with no effect
+	 */
+	void Initialize(class UCameraComponent* _camera, class USpringArmComponent* _cameraBoom, float _baseFov, float _baseArmLength);
+
+	/**
+	 * Starts blending a layer in or out
+	 * @author Richard Wulansari
+	 * @param _layer
+	 * @param _bActive
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Effects")
+	void SetLayerActive(ECameraEffectLayer _layer, bool _bActive);
+
+	/**
+	 * Sets the post process that follows the weight of a layer
+	 * @author Richard Wulansari
+	 * @param _layer
+	 * @param _postProcess
+	 */
+	void SetLayerPostProcess(ECameraEffectLayer _layer, class UPostProcessComponent* _postProcess);
+
+	/**
+	 * Snaps all the layers to inactive
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Camera Effects")
+	void ResetLayers();
+
+	/** Getter */
+	UFUNCTION(BlueprintPure, Category = "Camera Effects")
+	float GetLayerWeight(ECameraEffectLayer _layer) const;
+	/** Getter End */
+
+private:
+
+	/** Applies the weights of all the layers to the camera */
+	void ApplyLayers();
+
+};
@@ -12,8 +12,9 @@
 // Sets default values for this component's properties
 UCharacterSprintMovementComponent::UCharacterSprintMovementComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.
+	// Only ticks while the sprint is held, to catch the character starting or stopping to move
 	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 }
 
@@ -36,15 +37,33 @@ void UCharacterSprintMovementComponent::BeginPlay()
 		{
 			WalkSpeed = CharacterMovementComponent->MaxWalkSpeed;
 		}
+
+		// Landing and falling can change the sprint state
+		CharacterOwner->MovementModeChangedDelegate.AddDynamic(this, &UCharacterSprintMovementComponent::OnOwnerMovementModeChanged);
 	}
+
+	SetComponentTickInterval(SprintCheckInterval);
+}
+
+void UCharacterSprintMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (CharacterOwner)
+		CharacterOwner->MovementModeChangedDelegate.RemoveDynamic(this, &UCharacterSprintMovementComponent::OnOwnerMovementModeChanged);
 }
 
 
-// Called every frame
+// Called only while the sprint is held
 void UCharacterSprintMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	UpdateSprintState();
+}
+
+void UCharacterSprintMovementComponent::UpdateSprintState()
+{
 	// Validate data within this class
 	if (!HasValidData()) return;
 	
@@ -102,11 +121,20 @@ void UCharacterSprintMovementComponent::TickComponent(float DeltaTime, ELevelTic
 void UCharacterSprintMovementComponent::Sprint()
 {
 	bWantsToSprint = true;
+	SetComponentTickEnabled(true);
+	UpdateSprintState();
 }
 
 void UCharacterSprintMovementComponent::UnSprint()
 {
 	bWantsToSprint = false;
+	SetComponentTickEnabled(false);
+	UpdateSprintState();
+}
+
+void UCharacterSprintMovementComponent::OnOwnerMovementModeChanged(ACharacter* _character, EMovementMode _prevMovementMode, uint8 _previousCustomMode)
+{
+	UpdateSprintState();
 }
 
 bool UCharacterSprintMovementComponent::HasValidData() const
@@ -56,6 +56,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement | Sprint")
 	float SprintSpeedMultiplier = 1.5f;
 
+	/** How often the sprint requirements are checked while the sprint is held */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Movement | Sprint")
+	float SprintCheckInterval = 0.1f;
+
 	UPROPERTY(BlueprintAssignable)
 	FSprintComponentDelegate OnSprintBegin;
 
@@ -66,10 +70,21 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
+	// Called when the game ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 public:	
-	// Called every frame
+	// Called only while the sprint is held, at SprintCheckInterval
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	/**
+	 * Starts or stops the sprint if the requirements has changed
+	 * @author Richard Wulansari
+	 * @note Called on input and movement mode change, no need to call this every frame
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement | Sprint")
+	void UpdateSprintState();
+
 	/**
 	 * Set the bWantsToSprint to true
 	 * @author: Richard Wulansari
@@ -106,4 +121,8 @@ private:
 	 */
 	bool HasValidData() const;
 
+	/** Called when the movement mode of the owner has changed, e.g. landing */
+	UFUNCTION()
+	void OnOwnerMovementModeChanged(class ACharacter* _character, EMovementMode _prevMovementMode, uint8 _previousCustomMode);
+
 };
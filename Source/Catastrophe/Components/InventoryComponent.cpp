@@ -4,16 +4,19 @@
 #include "InventoryComponent.h"
 
 #include "Characters/PlayerCharacter/UtilitySacks/ItemSack.h"
+#include "Characters/PlayerCharacter/PlayerCharacter.h"
+#include "Characters/PlayerCharacter/PlayerHudModel.h"
 
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 
+#include "DebugUtility/CatastropheDebug.h"
+
 // Sets default values for this component's properties
 UInventoryComponent::UInventoryComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
-	PrimaryComponentTick.bCanEverTick = true;
+	// The selection is updated by events, no need to tick
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 // Called when the game starts
@@ -22,11 +25,12 @@ void UInventoryComponent::BeginPlay()
 	Super::BeginPlay();
 	
 	CurrentSelection = 0;
+	UpdateHudModel();
 }
 
 void UInventoryComponent::AddItemType(class AItemSack* _newItem)
 {
-	ItemSacks.Add(_newItem);
+	TrackItemSack(ItemSacks.Add(_newItem));
 }
 
 void UInventoryComponent::InitialiseItemTypes(TArray<TSubclassOf<class AItemSack>> _items)
@@ -36,16 +40,23 @@ void UInventoryComponent::InitialiseItemTypes(TArray<TSubclassOf<class AItemSack
 		AItemSack* newItemSack = GetWorld()->SpawnActor<AItemSack>(_items[i], FTransform::Identity);
 		if (newItemSack)
 		{
-			ItemSacks.Add(newItemSack);
+			TrackItemSack(ItemSacks.Add(newItemSack));
 		}
 	}
+
+	UpdateHudModel();
 }
 
 void UInventoryComponent::ReplaceItemTypeWith(int _position, class AItemSack* _newItem)
 {
 	if (ItemSacks.Num() > _position)
 	{
+		if (ItemSacks[_position])
+			ItemSacks[_position]->OnItemAmountChanged.RemoveDynamic(this, &UInventoryComponent::OnItemSackAmountChanged);
+
 		ItemSacks[_position] = _newItem;
+		TrackItemSack(_position);
+		UpdateHudModel();
 	}
 }
 
@@ -60,7 +71,7 @@ void UInventoryComponent::PickupItem(TSubclassOf<class AItemSack> _newItemType)
 				ItemSacks[i]->AddItem();
 
 				// Set currently selected item to this one
-				CurrentSelection = i;
+				SetCurrentSelection(i);
 			}
 			return;
 		}
@@ -79,7 +90,7 @@ void UInventoryComponent::PickupItems(TSubclassOf<class AItemSack> _newItemType,
 			{
 				ItemSacks[i]->AddItems(_amount);
 
-				CurrentSelection = i;
+				SetCurrentSelection(i);
 			}
 			return;
 		}
@@ -136,25 +147,13 @@ class AItemSack* UInventoryComponent::GetCurrentItemSack()
 
 class AItemSack* UInventoryComponent::GetPreviousItemSack()
 {
-	int previousItemSack = CurrentSelection;
-
 	if (ItemSacks.Num() > CurrentSelection && CurrentSelection >= 0)
 	{
-		for (int i = 0; i < ItemSacks.Num() - 1; ++i)
+		// The previous sack is not shown if it is the same as the next one
+		const int32 previousSlot = FindPreviousNonEmptySlot(CurrentSelection);
+		if (previousSlot != INDEX_NONE && previousSlot != FindNextNonEmptySlot(CurrentSelection))
 		{
-			if (previousItemSack == 0)
-			{
-				previousItemSack = ItemSacks.Num() - 1;
-			}
-			else
-			{
-				previousItemSack--;
-			}
-
-			if (!ItemSacks[previousItemSack]->IsItemSackEmpty() && ItemSacks[previousItemSack] != GetNextItemSack())
-			{
-				return ItemSacks[previousItemSack];
-			}
+			return ItemSacks[previousSlot];
 		}
 	}
 	else
@@ -166,28 +165,12 @@ class AItemSack* UInventoryComponent::GetPreviousItemSack()
 
 class AItemSack* UInventoryComponent::GetNextItemSack()
 {
-	int nextItemSack = CurrentSelection;
-
 	if (ItemSacks.Num() > CurrentSelection && CurrentSelection >= 0)
 	{
-		for (int i = 0; i < ItemSacks.Num() - 1; ++i)
+		const int32 nextSlot = FindNextNonEmptySlot(CurrentSelection);
+		if (nextSlot != INDEX_NONE)
 		{
-			if (nextItemSack == ItemSacks.Num() - 1)
-			{
-				if (ItemSacks.Num() > 0)
-				{
-					nextItemSack = 0;
-				}
-			}
-			else
-			{
-				nextItemSack++;
-			}
-
-			if (!ItemSacks[nextItemSack]->IsItemSackEmpty())
-			{
-				return ItemSacks[nextItemSack];
-			}
+			return ItemSacks[nextSlot];
 		}
 	}
 	else
@@ -199,41 +182,21 @@ class AItemSack* UInventoryComponent::GetNextItemSack()
 
 void UInventoryComponent::ChoosePreviousItem()
 {
-	for (int i = 0; i < ItemSacks.Num(); ++i)
+	// Stays on the current slot if no other sack has items
+	const int32 previousSlot = FindPreviousNonEmptySlot(CurrentSelection);
+	if (previousSlot != INDEX_NONE)
 	{
-		if (CurrentSelection == 0)
-		{
-			CurrentSelection = ItemSacks.Num() - 1;
-		}
-		else
-		{
-			CurrentSelection--;
-		}
-
-		if (!ItemSacks[CurrentSelection]->IsItemSackEmpty())
-		{
-			return;
-		}
+		SetCurrentSelection(previousSlot);
 	}
 }
 
 void UInventoryComponent::ChooseNextItem()
 {
-	for (int i = 0; i < ItemSacks.Num(); ++i)
+	// Stays on the current slot if no other sack has items
+	const int32 nextSlot = FindNextNonEmptySlot(CurrentSelection);
+	if (nextSlot != INDEX_NONE)
 	{
-		if (CurrentSelection == ItemSacks.Num() - 1)
-		{
-			CurrentSelection = 0;
-		}
-		else
-		{
-			CurrentSelection++;
-		}
-
-		if (!ItemSacks[CurrentSelection]->IsItemSackEmpty())
-		{
-			return;
-		}
+		SetCurrentSelection(nextSlot);
 	}
 }
 
@@ -257,3 +220,89 @@ void UInventoryComponent::UseItem(bool _bAiming)
 
 	}
 }
+
+void UInventoryComponent::UpdateHudModel()
+{
+	APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(GetOwner());
+	if (!playerCharacter || !playerCharacter->GetHudModel()) return;
+
+	AItemSack* currentSack = (CurrentSelection >= 0 && ItemSacks.Num() > CurrentSelection) ? ItemSacks[CurrentSelection] : nullptr;
+	playerCharacter->GetHudModel()->SetCurrentItem(currentSack, currentSack ? currentSack->GetItemAmount() : 0);
+}
+
+void UInventoryComponent::SetCurrentSelection(int32 _selection)
+{
+	if (CurrentSelection == _selection) return;
+
+	CurrentSelection = (int8)_selection;
+	UpdateHudModel();
+	OnSelectionChanged.Broadcast(GetCurrentItemSack());
+}
+
+void UInventoryComponent::TrackItemSack(int32 _slot)
+{
+	if (_slot >= MaxSlots)
+	{
+		CatastropheDebug::OnScreenErrorMsg(TEXT("InventoryComponent: Too many item sacks, the extra sacks will be ignored"), 30.0f);
+		UE_LOG(LogTemp, Error, TEXT("InventoryComponent: Too many item sacks, the extra sacks will be ignored"));
+		return;
+	}
+
+	AItemSack* itemSack = ItemSacks[_slot];
+	const uint32 slotBit = 1u << _slot;
+	if (itemSack)
+	{
+		itemSack->OnItemAmountChanged.AddUniqueDynamic(this, &UInventoryComponent::OnItemSackAmountChanged);
+		NonEmptySackMask = itemSack->IsItemSackEmpty() ? (NonEmptySackMask & ~slotBit) : (NonEmptySackMask | slotBit);
+	}
+	else
+	{
+		NonEmptySackMask &= ~slotBit;
+	}
+}
+
+void UInventoryComponent::OnItemSackAmountChanged(AItemSack* _itemSack)
+{
+	const int32 slot = ItemSacks.IndexOfByKey(_itemSack);
+	if (slot == INDEX_NONE || slot >= MaxSlots) return;
+
+	const uint32 slotBit = 1u << slot;
+	NonEmptySackMask = _itemSack->IsItemSackEmpty() ? (NonEmptySackMask & ~slotBit) : (NonEmptySackMask | slotBit);
+
+	if (slot == CurrentSelection)
+		UpdateHudModel();
+}
+
+int32 UInventoryComponent::FindNextNonEmptySlot(int32 _slot) const
+{
+	if (_slot < 0 || _slot >= MaxSlots) return INDEX_NONE;
+
+	// The slots after this one first, then wrap around to the ones before it
+	const uint32 slotBit = 1u << _slot;
+	const uint32 afterMask = NonEmptySackMask & ~((slotBit << 1) - 1);
+	if (afterMask != 0)
+		return (int32)FMath::CountTrailingZeros(afterMask);
+
+	const uint32 beforeMask = NonEmptySackMask & (slotBit - 1);
+	if (beforeMask != 0)
+		return (int32)FMath::CountTrailingZeros(beforeMask);
+
+	return INDEX_NONE;
+}
+
+int32 UInventoryComponent::FindPreviousNonEmptySlot(int32 _slot) const
+{
+	if (_slot < 0 || _slot >= MaxSlots) return INDEX_NONE;
+
+	// The slots before this one first, then wrap around to the ones after it
+	const uint32 slotBit = 1u << _slot;
+	const uint32 beforeMask = NonEmptySackMask & (slotBit - 1);
+	if (beforeMask != 0)
+		return (int32)FMath::FloorLog2(beforeMask);
+
+	const uint32 afterMask = NonEmptySackMask & ~((slotBit << 1) - 1);
+	if (afterMask != 0)
+		return (int32)FMath::FloorLog2(afterMask);
+
+	return INDEX_NONE;
+}
@@ -6,6 +6,9 @@
 #include "Components/ActorComponent.h"
 #include "InventoryComponent.generated.h"
 
+/** Delegate declaration */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInventorySelectionSignature, class AItemSack*, _currentItemSack);
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class CATASTROPHE_API UInventoryComponent : public UActorComponent
 {
@@ -19,10 +22,20 @@ private:
 	UPROPERTY()
 	TArray<class AItemSack*> ItemSacks;
 
+	/** One bit per slot, set if the sack in the slot is not empty */
+	uint32 NonEmptySackMask = 0;
+
 public:
 	// Sets default values for this component's properties
 	UInventoryComponent();
 
+	/** Maximum number of slots the inventory can track */
+	static const int32 MaxSlots = 32;
+
+	/** Called when the currently selected item sack has changed */
+	UPROPERTY(BlueprintAssignable)
+	FInventorySelectionSignature OnSelectionChanged;
+
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
@@ -137,4 +150,46 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ItemUseSystem")
 	void UseItem(bool _bAiming);
+
+private:
+
+	/**
+	 * Writes the current item sack and its amount into the player hud model
+	 * @author Richard Wulansari
+	 */
+	void UpdateHudModel();
+
+	/**
+	 * Changes the current selection, notifies if it has changed
+	 * @author Richard Wulansari
+	 * @param _selection
+	 */
+	void SetCurrentSelection(int32 _selection);
+
+	/**
+	 * Starts tracking a sack that has been put into a slot
+	 * @author Richard Wulansari
+	 * @param _slot
+	 */
+	void TrackItemSack(int32 _slot);
+
+	/** Called when the amount of a sack has changed, keeps the non empty mask up to date */
+	UFUNCTION()
+	void OnItemSackAmountChanged(class AItemSack* _itemSack);
+
+	/**
+	 * Finds the next non empty slot after a slot, wraps around
+	 * @author Richard Wulansari
+	 * @param _slot The slot to start from, it is not included in the search
+	 * @return INDEX_NONE if no other slot is not empty
+	 */
+	int32 FindNextNonEmptySlot(int32 _slot) const;
+
+	/**
+	 * Finds the previous non empty slot before a slot, wraps around
+	 * @author Richard Wulansari
+	 * @param _slot The slot to start from, it is not included in the search
+	 * @return INDEX_NONE if no other slot is not empty
+	 */
+	int32 FindPreviousNonEmptySlot(int32 _slot) const;
 };
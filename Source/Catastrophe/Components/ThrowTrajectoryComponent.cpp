@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ThrowTrajectoryComponent.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UThrowTrajectoryComponent::UThrowTrajectoryComponent()
+{
+	// The owner drives the update while aiming
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SweepDelegate.BindUObject(this, &UThrowTrajectoryComponent::OnSweepCompleted);
+}
+
+bool UThrowTrajectoryComponent::UpdatePrediction(const FVector& _startLocation, const FVector& _launchVelocity, float _gravityZ, AActor* _ignoredActor)
+{
+	// Reuse the arc if the launch has barely changed
+	const bool bLaunchChanged =
+		!bHasCachedArc ||
+		_gravityZ != CachedGravityZ ||
+		FVector::DistSquared(_startLocation, CachedStartLocation) > FMath::Square(LocationTolerance) ||
+		FVector::DistSquared(_launchVelocity, CachedLaunchVelocity) > FMath::Square(VelocityTolerance);
+
+	if (bLaunchChanged && SimFrequency > 0.0f)
+	{
+		bHasCachedArc = true;
+		CachedStartLocation = _startLocation;
+		CachedLaunchVelocity = _launchVelocity;
+		CachedGravityZ = _gravityZ;
+		IgnoredActor = _ignoredActor;
+
+		// p(t) = p0 + v * t + 0.5 * g * t^2, no need to step a simulation
+		const int32 pointCount = FMath::Max(2, FMath::CeilToInt(MaxSimTime * SimFrequency) + 1);
+		const float timeStep = MaxSimTime / (pointCount - 1);
+		const FVector gravity(0.0f, 0.0f, _gravityZ);
+		ArcPoints.Reset(pointCount);
+		for (int32 i = 0; i < pointCount; ++i)
+		{
+			const float time = i * timeStep;
+			ArcPoints.Add(_startLocation + (_launchVelocity * time) + (0.5f * gravity * time * time));
+		}
+
+		if (!bHasSweepResult)
+		{
+			// Nothing to show yet, the arc must not go through the geometry until the sweeps are back
+			SweepArcSynchronously();
+		}
+		else
+		{
+			// Show the new arc clipped at the last known hit until the sweeps are back
+			BuildPredictedPath(CommittedHitSegment, CommittedHitTime);
+
+			// The batch in flight is still used, the sweeps of the new arc are sent once it is back
+			if (PendingSweeps.Num() > 0)
+				bArcChangedDuringSweep = true;
+			else
+				SweepArc();
+		}
+	}
+
+	const bool bPathChanged = bPredictedPathDirty;
+	bPredictedPathDirty = false;
+	return bPathChanged;
+}
+
+void UThrowTrajectoryComponent::InvalidatePrediction()
+{
+	bHasCachedArc = false;
+	PendingSweeps.Reset();
+	bArcChangedDuringSweep = false;
+
+	// The hit belongs to the old arc, the next arc must not be clipped by it
+	bHasSweepResult = false;
+	CommittedHitSegment = INDEX_NONE;
+	BatchHitSegment = INDEX_NONE;
+}
+
+void UThrowTrajectoryComponent::SweepArc()
+{
+	UWorld* world = GetWorld();
+	if (!world)
+		return;
+
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(ThrowTrajectory), false, IgnoredActor.Get());
+	const FCollisionShape sweepShape = FCollisionShape::MakeSphere(ProjectileRadius);
+
+	// All the segments at once, batches sent one after the other would never reach the end of the arc while aiming
+	BatchHitSegment = INDEX_NONE;
+	for (int32 segment = 0; segment < ArcPoints.Num() - 1; ++segment)
+	{
+		PendingSweeps.Add(world->AsyncSweepByChannel(
+			EAsyncTraceType::Single,
+			ArcPoints[segment],
+			ArcPoints[segment + 1],
+			TraceChannel,
+			sweepShape,
+			queryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			&SweepDelegate,
+			(uint32)segment));
+	}
+}
+
+void UThrowTrajectoryComponent::SweepArcSynchronously()
+{
+	UWorld* world = GetWorld();
+	if (!world)
+		return;
+
+	FCollisionQueryParams queryParams(SCENE_QUERY_STAT(ThrowTrajectory), false, IgnoredActor.Get());
+	const FCollisionShape sweepShape = FCollisionShape::MakeSphere(ProjectileRadius);
+
+	CommittedHitSegment = INDEX_NONE;
+	CommittedHitTime = 0.0f;
+	for (int32 segment = 0; segment < ArcPoints.Num() - 1; ++segment)
+	{
+		FHitResult hitResult;
+		if (world->SweepSingleByChannel(
+			hitResult,
+			ArcPoints[segment],
+			ArcPoints[segment + 1],
+			FQuat::Identity,
+			TraceChannel,
+			sweepShape,
+			queryParams))
+		{
+			CommittedHitSegment = segment;
+			CommittedHitTime = hitResult.Time;
+			break;
+		}
+	}
+
+	bHasSweepResult = true;
+	BuildPredictedPath(CommittedHitSegment, CommittedHitTime);
+}
+
+void UThrowTrajectoryComponent::OnSweepCompleted(const FTraceHandle& _traceHandle, FTraceDatum& _traceData)
+{
+	// Sweep from before the last invalidation
+	if (PendingSweeps.RemoveSwap(_traceHandle) == 0)
+		return;
+
+	const int32 segment = (int32)_traceData.UserData;
+	if (_traceData.OutHits.Num() > 0 && _traceData.OutHits[0].bBlockingHit &&
+		(BatchHitSegment == INDEX_NONE || segment < BatchHitSegment))
+	{
+		BatchHitSegment = segment;
+		BatchHitTime = _traceData.OutHits[0].Time;
+	}
+
+	if (PendingSweeps.Num() > 0)
+		return;
+
+	// Whole batch is back, the hit is placed on the current arc as it may have moved a little since
+	bHasSweepResult = true;
+	CommittedHitSegment = BatchHitSegment;
+	CommittedHitTime = BatchHitTime;
+	BuildPredictedPath(CommittedHitSegment, CommittedHitTime);
+
+	if (bArcChangedDuringSweep)
+	{
+		bArcChangedDuringSweep = false;
+		SweepArc();
+	}
+}
+
+void UThrowTrajectoryComponent::BuildPredictedPath(int32 _hitSegment, float _hitTime)
+{
+	const int32 lastPoint = (_hitSegment == INDEX_NONE) ?
+		ArcPoints.Num() - 1 : FMath::Min(_hitSegment, ArcPoints.Num() - 1);
+
+	PredictedPath.Reset(lastPoint + 2);
+	PredictedPath.Append(ArcPoints.GetData(), lastPoint + 1);
+	if (_hitSegment != INDEX_NONE && ArcPoints.IsValidIndex(lastPoint + 1))
+		PredictedPath.Add(FMath::Lerp(ArcPoints[lastPoint], ArcPoints[lastPoint + 1], _hitTime));
+
+	bPredictedPathDirty = true;
+}
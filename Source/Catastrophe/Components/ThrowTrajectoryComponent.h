@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "ThrowTrajectoryComponent.generated.h"
+
+/**
+ * This component predicts the arc of a thrown object
+ * The arc is calculated analytically, all of its segments are swept at once using async traces
+ * The result is reused while the launch location and velocity does not change much
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class CATASTROPHE_API UThrowTrajectoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+private:
+
+	/** Every sample point of the analytic arc, without collision */
+	TArray<FVector> ArcPoints;
+
+	/** The arc that is clipped at the hit location */
+	TArray<FVector> PredictedPath;
+
+	/** The inputs of the currently cached arc */
+	FVector CachedStartLocation;
+	FVector CachedLaunchVelocity;
+	float CachedGravityZ;
+	bool bHasCachedArc = false;
+
+	/** Set when PredictedPath changed since the last update */
+	bool bPredictedPathDirty = false;
+
+	/** True once a prediction has finished since the last invalidation, until then the arc is swept synchronously */
+	bool bHasSweepResult = false;
+
+	/** The segment that the last finished prediction hit, INDEX_NONE if nothing is hit */
+	int32 CommittedHitSegment = INDEX_NONE;
+
+	/** How far along the hit segment the hit is, from 0 to 1 */
+	float CommittedHitTime = 0.0f;
+
+	/** The sweeps of the current batch that has not returned yet */
+	TArray<FTraceHandle> PendingSweeps;
+
+	/** The closest hit of the current batch */
+	int32 BatchHitSegment = INDEX_NONE;
+	float BatchHitTime = 0.0f;
+
+	/** Set when the arc has changed while a batch is in flight, the arc is swept again once the batch is back */
+	bool bArcChangedDuringSweep = false;
+
+	/** The actor the sweeps are ignoring */
+	TWeakObjectPtr<AActor> IgnoredActor;
+
+	FTraceDelegate SweepDelegate;
+
+public:	
+	UThrowTrajectoryComponent();
+
+	/** Number of sample points per second of flight */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trajectory")
+	float SimFrequency = 15.0f;
+
+	/** Maximum flight time that will be predicted */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trajectory")
+	float MaxSimTime = 2.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trajectory")
+	float ProjectileRadius = 10.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trajectory")
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECollisionChannel::ECC_Visibility;
+
+	/** The prediction is reused while the launch location moves less than this, the sweeps are a frame late anyway */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trajectory")
+	float LocationTolerance = 10.0f;
+
+	/** The prediction is reused while the launch velocity changes less than this */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Trajectory")
+	float VelocityTolerance = 25.0f;
+
+public:	
+
+	/**
+	 * Updates the prediction with the current launch parameters
+	 * @author Richard Wulansari
+	 * @param _startLocation Where the object is thrown from
+	 * @param _launchVelocity The initial velocity of the object
+	 * @param _gravityZ The gravity applied to the object
+	 * @param _ignoredActor Actor that is not blocking the object, usually the thrower
+	 * @return True if the predicted path has changed since the last update
+	 */
+	bool UpdatePrediction(const FVector& _startLocation, const FVector& _launchVelocity, float _gravityZ, AActor* _ignoredActor);
+
+	/** Drops the cached arc, the next update will predict again */
+	void InvalidatePrediction();
+
+	/** Getter */
+	FORCEINLINE const TArray<FVector>& GetPredictedPath() const { return PredictedPath; }
+	/** Getter End */
+
+private:
+
+	/** Sends the sweeps of every segment of the arc in one batch */
+	void SweepArc();
+
+	/** Sweeps the arc on the game thread until the first hit, used when there is no earlier result to show */
+	void SweepArcSynchronously();
+
+	/** Called when one of the async sweeps has finished */
+	void OnSweepCompleted(const FTraceHandle& _traceHandle, FTraceDatum& _traceData);
+
+	/**
+	 * Builds PredictedPath from the arc clipped at the hit
+	 * @author Richard Wulansari
+	 * @param _hitSegment INDEX_NONE if nothing is hit
+	 * @param _hitTime How far along the segment the hit is, from 0 to 1
+	 */
+	void BuildPredictedPath(int32 _hitSegment, float _hitTime);
+
+};
@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "TraversalComponent.h"
+
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "Components/CapsuleComponent.h"
+
+UTraversalComponent::UTraversalComponent()
+{
+	// Only ticks while a traversal is in progress
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UTraversalComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// Never leave the character stuck in the traversal movement mode
+	if (bHoldingCharacter)
+		ReleaseCharacter();
+}
+
+void UTraversalComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!IsValid(TraversingCharacter))
+	{
+		SetComponentTickEnabled(false);
+		bHoldingCharacter = false;
+		return;
+	}
+
+	ElapsedTime += DeltaTime;
+	const float totalDistance = PathDistances.Last();
+	const float alpha = TraversalDuration > 0.0f ? FMath::Min(ElapsedTime / TraversalDuration, 1.0f) : 1.0f;
+	const float distance = alpha * totalDistance;
+
+	// The segment only moves forward, no need to search the path
+	while (CurrentSegment < PathPoints.Num() - 2 && PathDistances[CurrentSegment + 1] < distance)
+	{
+		CurrentSegment++;
+	}
+
+	const float segmentLength = PathDistances[CurrentSegment + 1] - PathDistances[CurrentSegment];
+	const float segmentAlpha = segmentLength > 0.0f ? (distance - PathDistances[CurrentSegment]) / segmentLength : 1.0f;
+	MoveCharacter(FMath::Lerp(PathPoints[CurrentSegment], PathPoints[CurrentSegment + 1], segmentAlpha));
+
+	if (alpha >= 1.0f)
+		FinishTraversal();
+}
+
+bool UTraversalComponent::BeginTraversal(ACharacter* _character, const TArray<FVector>& _pathPoints, float _duration)
+{
+	if (!IsValid(_character) || _pathPoints.Num() == 0 || IsTraversing())
+		return false;
+
+	HoldCharacter(_character);
+
+	// Precompute the distance along the path once
+	PathPoints.Reset(_pathPoints.Num() + 1);
+	PathDistances.Reset(_pathPoints.Num() + 1);
+	PathPoints.Add(_character->GetActorLocation());
+	PathDistances.Add(0.0f);
+	for (const FVector& point : _pathPoints)
+	{
+		PathDistances.Add(PathDistances.Last() + FVector::Dist(PathPoints.Last(), point));
+		PathPoints.Add(point);
+	}
+
+	CurrentSegment = 0;
+	ElapsedTime = 0.0f;
+	TraversalDuration = _duration;
+
+	if (_duration <= 0.0f)
+	{
+		MoveCharacter(PathPoints.Last());
+		FinishTraversal();
+	}
+	else
+	{
+		SetComponentTickEnabled(true);
+	}
+	return true;
+}
+
+void UTraversalComponent::TeleportCharacter(ACharacter* _character, const FVector& _location, const FRotator& _rotation, bool _bHoldCharacter)
+{
+	if (!IsValid(_character)) return;
+
+	if (!bHoldingCharacter || TraversingCharacter != _character)
+		HoldCharacter(_character);
+
+	_character->SetActorLocationAndRotation(_location, _rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	if (AController* controller = _character->GetController())
+		controller->SetControlRotation(_rotation);
+
+	if (!_bHoldCharacter)
+		ReleaseCharacter();
+}
+
+void UTraversalComponent::TeleportCharacter(ACharacter* _character, const FVector& _location, bool _bHoldCharacter)
+{
+	if (!IsValid(_character)) return;
+
+	if (!bHoldingCharacter || TraversingCharacter != _character)
+		HoldCharacter(_character);
+
+	MoveCharacter(_location);
+
+	if (!_bHoldCharacter)
+		ReleaseCharacter();
+}
+
+void UTraversalComponent::ReleaseCharacter()
+{
+	SetComponentTickEnabled(false);
+	bHoldingCharacter = false;
+	if (!IsValid(TraversingCharacter)) return;
+
+	// Overlaps were not updated during the move, update them once at the destination
+	if (UCapsuleComponent* capsule = TraversingCharacter->GetCapsuleComponent())
+	{
+		capsule->SetGenerateOverlapEvents(bCapsuleGeneratedOverlaps);
+		capsule->UpdateOverlaps();
+	}
+
+	UCharacterMovementComponent* characterMovement = TraversingCharacter->GetCharacterMovement();
+	if (characterMovement->MovementMode == MOVE_Custom &&
+		characterMovement->CustomMovementMode == TraversalCustomMode)
+	{
+		characterMovement->SetDefaultMovementMode();
+	}
+
+	TraversingCharacter = nullptr;
+}
+
+void UTraversalComponent::HoldCharacter(ACharacter* _character)
+{
+	TraversingCharacter = _character;
+	bHoldingCharacter = true;
+
+	// No gravity or walking logic while being moved
+	UCharacterMovementComponent* characterMovement = _character->GetCharacterMovement();
+	characterMovement->StopMovementImmediately();
+	characterMovement->SetMovementMode(MOVE_Custom, TraversalCustomMode);
+
+	if (UCapsuleComponent* capsule = _character->GetCapsuleComponent())
+	{
+		bCapsuleGeneratedOverlaps = capsule->GetGenerateOverlapEvents();
+		capsule->SetGenerateOverlapEvents(false);
+	}
+}
+
+void UTraversalComponent::FinishTraversal()
+{
+	ACharacter* character = TraversingCharacter;
+	ReleaseCharacter();
+	OnTraversalComplete.Broadcast(character);
+}
+
+void UTraversalComponent::MoveCharacter(const FVector& _location)
+{
+	TraversingCharacter->SetActorLocation(_location, false, nullptr, ETeleportType::TeleportPhysics);
+}
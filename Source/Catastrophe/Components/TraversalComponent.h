@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TraversalComponent.generated.h"
+
+/** Delegate declaration */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTraversalSignature, class ACharacter*, _character);
+
+/**
+ * This component moves a character along a precomputed path, e.g. climbing a stall, going through a vent
+ * The character is put into a custom movement mode and moved without sweeps, its overlaps are only updated on arrival
+ * The component only ticks while a traversal is in progress
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class CATASTROPHE_API UTraversalComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+private:
+
+	/** The character that is being moved */
+	UPROPERTY()
+	class ACharacter* TraversingCharacter;
+
+	/** The path including the start location */
+	TArray<FVector> PathPoints;
+
+	/** The path distance at each point */
+	TArray<float> PathDistances;
+
+	/** The segment the character is currently on */
+	int32 CurrentSegment = 0;
+
+	float TraversalDuration = 0.0f;
+
+	float ElapsedTime = 0.0f;
+
+	/** True if the character is being held by this component */
+	bool bHoldingCharacter = false;
+
+	/** If the capsule of the character generated overlaps before it was held */
+	bool bCapsuleGeneratedOverlaps = false;
+
+public:
+	UTraversalComponent();
+
+	/** The custom movement mode used while traversing */
+	static const uint8 TraversalCustomMode = 0;
+
+	/** Called when the character has arrived at the end of the path */
+	UPROPERTY(BlueprintAssignable)
+	FTraversalSignature OnTraversalComplete;
+
+protected:
+	// Called when the game ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// Called only while a traversal is in progress
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * Moves the character along a path at constant speed
+	 * @author Richard Wulansari
+	 * @param _character The character to move
+	 * @param _pathPoints The points to go through, the current location of the character is the start
+	 * @param _duration How long the whole path takes, arrives immediately if zero
+	 * @return False if the traversal could not start
+	 */
+	bool BeginTraversal(class ACharacter* _character, const TArray<FVector>& _pathPoints, float _duration);
+
+	/**
+	 * Moves the character to a transform immediately
+	 * @author Richard Wulansari
+	 * @param _character The character to move
+	 * @param _location
+	 * @param _rotation Also applied to the controller
+	 * @param _bHoldCharacter If true, the character stays in the traversal movement mode until ReleaseCharacter
+	 */
+	void TeleportCharacter(class ACharacter* _character, const FVector& _location, const FRotator& _rotation, bool _bHoldCharacter);
+
+	/**
+	 * Moves the character to a location immediately, the rotation is kept
+	 * @author Richard Wulansari
+	 * @param _character The character to move
+	 * @param _location
+	 * @param _bHoldCharacter If true, the character stays in the traversal movement mode until ReleaseCharacter
+	 */
+	void TeleportCharacter(class ACharacter* _character, const FVector& _location, bool _bHoldCharacter);
+
+	/**
+	 * Returns the held character back to its default movement mode
+	 * @author Richard Wulansari
+	 */
+	void ReleaseCharacter();
+
+	/** Getter */
+	FORCEINLINE bool IsTraversing() const { return IsComponentTickEnabled(); }
+	FORCEINLINE bool IsHoldingCharacter() const { return bHoldingCharacter; }
+	/** Getter End */
+
+private:
+
+	/** Puts the character into the traversal movement mode and stops its overlap updates */
+	void HoldCharacter(class ACharacter* _character);
+
+	/** Finishes the traversal, the overlaps of the character are updated once */
+	void FinishTraversal();
+
+	/**
+	 * Moves the character without a sweep
+	 * @author Richard Wulansari
+	 * @param _location
+	 */
+	void MoveCharacter(const FVector& _location);
+
+};
@@ -5,6 +5,8 @@
 
 #include "Components/StaticMeshComponent.h"
 
+#include "RespawnSystem/PostLoadInitSubsystem.h"
+
 // Sets default values
 AProceduralMultiMeshActor::AProceduralMultiMeshActor()
 {
@@ -18,8 +20,12 @@ void AProceduralMultiMeshActor::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	// Reload at beginplay
-	ReloadMeshes();
+	// Reload after the level has been added, spread with the rest of the post load work
+	UPostLoadInitSubsystem::ScheduleWork(this, [this]()
+	{
+		if (HasActorBegunPlay())
+			ReloadMeshes();
+	});
 
 }
 
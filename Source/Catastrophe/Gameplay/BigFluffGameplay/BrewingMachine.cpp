@@ -45,7 +45,7 @@ ABrewingMachine::ABrewingMachine()
 	InteractionTrigger->SetupAttachment(BrewingMachineMesh);
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
-	InteractableComponent->RegisterTriggerVolume(InteractionTrigger);
+	InteractableComponent->RegisterTriggerVolume(InteractionTrigger, true);
 	InteractableComponent->OnInteractTickBegin.RemoveDynamic(this, &ABrewingMachine::OnInteractBegin);
 	InteractableComponent->OnInteractTickBegin.AddDynamic(this, &ABrewingMachine::OnInteractBegin);
 	InteractableComponent->OnInteractSuccess.RemoveDynamic(this, &ABrewingMachine::OnInteractSuccess);
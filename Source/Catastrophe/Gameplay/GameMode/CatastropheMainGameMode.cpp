@@ -5,6 +5,7 @@
 
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "TimerManager.h"
 
 #include "Characters/PlayerCharacter/PlayerCharacter.h"
 #include "Characters/GuardCharacter/Guard.h"
@@ -14,8 +15,10 @@
 #include "QuestSystem/Quest.h"
 #include "QuestSystem/QuestObjectiveComponent.h"
 #include "QuestSystem/QuestWidget.h"
+#include "Characters/PlayerCharacter/PlayerHudModel.h"
 
 #include "RespawnSystem/RespawnSubsystem.h"
+#include "RespawnSystem/StreamingTelemetrySubsystem.h"
 #include "QuestSystem/QuestSubsystem.h"
 
 #include "DebugUtility/CatastropheDebug.h"
@@ -41,35 +44,56 @@ void ACatastropheMainGameMode::Tick(float DeltaSeconds)
 void ACatastropheMainGameMode::AddChasingGuard(AActor* _guard)
 {
 	// Only add guard reference if it doesn't already exists
-	if (!ChasingGuards.Contains(_guard))
+	if (!IsValid(_guard) || ChasingGuards.Contains(_guard))
+		return;
+
+	// Show the spotted effect if this is the first guard chasing
+	if (ChasingGuards.Num() == 0)
 	{
-		// Show the spotted effect if this is the first guard chasing
-		if (ChasingGuards.Num() == 0)
+		if (PlayerCharacter)
 		{
-			APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
-			if (playerCharacter) playerCharacter->ToggleSpottedAlert(true);
+			PlayerCharacter->ToggleSpottedAlert(true);
+			LastKnownPlayerLocation = PlayerCharacter->GetActorLocation();
 		}
 
-		ChasingGuards.Add(_guard);
+		// Start ranking the chase slots
+		GetWorldTimerManager().SetTimer(ChaseSlotTimerHandle, this,
+			&ACatastropheMainGameMode::UpdateChaseSlots, ChaseSlotUpdateInterval, true);
 	}
+
+	ChasingGuards.Add(_guard);
+	UpdateChaseSlots();
 }
 
 void ACatastropheMainGameMode::RemoveOneChasingGuard(AActor* _guard)
 {
 	// Remove the guard reference only if it already exists
-	if (ChasingGuards.Contains(_guard))
-	{
-		ChasingGuards.Remove(_guard);
+	if (ChasingGuards.Remove(_guard) <= 0)
+		return;
 
-		// If no more guard chasing, remove the spotted effect on the player
-		if (ChasingGuards.Num() == 0)
-		{
-			APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(this, 0));
-			if (playerCharacter) playerCharacter->ToggleSpottedAlert(false);
-		}
+	// Guard that stopped chasing always goes back to the full tick rate
+	ChaseSlotGuards.Remove(_guard);
+	if (AGuard* guard = Cast<AGuard>(_guard))
+		guard->SetChaseSlotGranted(true);
+
+	// If no more guard chasing, remove the spotted effect on the player
+	if (ChasingGuards.Num() == 0)
+	{
+		GetWorldTimerManager().ClearTimer(ChaseSlotTimerHandle);
+		if (PlayerCharacter) PlayerCharacter->ToggleSpottedAlert(false);
+	}
+	else
+	{
+		// Give the freed slot to the next best guard
+		UpdateChaseSlots();
 	}
 }
 
+bool ACatastropheMainGameMode::HasChaseSlot(AActor* _guard) const
+{
+	return ChaseSlotGuards.Contains(_guard);
+}
+
 void ACatastropheMainGameMode::InitiateQteBobEvent_Implementation(class AGuard* _guard)
 {
 	if (!IsValid(CurrentGuardQteEvent) && IsValid(_guard))
@@ -95,11 +119,14 @@ void ACatastropheMainGameMode::OnQuestObjectiveCompletion(class UQuestObjectiveC
 
 	if (_CurrentObjective->GetOrder() < CurrentQuest->GetObjectives().Num() - 1)
 	{
-		PlayerCharacter->GetQuestWidget()->NewQuestObjective(CurrentQuest->GetObjectiveByID(_CurrentObjective->GetOrder() + 1)->GetPopupText());
+		const FString objectiveText = CurrentQuest->GetObjectiveByID(_CurrentObjective->GetOrder() + 1)->GetPopupText();
+		PlayerCharacter->GetQuestWidget()->NewQuestObjective(objectiveText);
+		PlayerCharacter->GetHudModel()->SetQuestText(objectiveText);
 	}
 	else
 	{
 		PlayerCharacter->GetQuestWidget()->QuestCompleted(_bUnlocksNewQuest);
+		PlayerCharacter->GetHudModel()->SetQuestText(FString());
 	}
 }
 
@@ -162,6 +189,54 @@ void ACatastropheMainGameMode::OnGuardQteFailed()
 		QteGuard->OnCatchPlayerSuccess();
 }
 
+void ACatastropheMainGameMode::UpdateChaseSlots()
+{
+	if (!IsValid(PlayerCharacter))
+		return;
+
+	const FVector playerLocation = PlayerCharacter->GetActorLocation();
+
+	// Rank all the chasing guards, guards with sight on the player comes first
+	TArray<TPair<float, AGuard*>> rankedGuards;
+	rankedGuards.Reserve(ChasingGuards.Num());
+	bool bAnyGuardHasSight = false;
+	for (AActor* actor : ChasingGuards)
+	{
+		AGuard* guard = Cast<AGuard>(actor);
+		if (!IsValid(guard))
+			continue;
+
+		float rank = FVector::DistSquared(guard->GetActorLocation(), playerLocation);
+		if (guard->bPlayerInSight)
+			bAnyGuardHasSight = true;
+		else
+			rank += FMath::Square(NoSightRankPenalty);
+
+		rankedGuards.Emplace(rank, guard);
+	}
+	rankedGuards.Sort([](const TPair<float, AGuard*>& _a, const TPair<float, AGuard*>& _b) {
+		return _a.Key < _b.Key;
+	});
+
+	// Only update the shared location when someone can actually see the player
+	if (bAnyGuardHasSight)
+		LastKnownPlayerLocation = playerLocation;
+
+	// Hand out the slots, the rest of the guards converge on the last known location
+	ChaseSlotGuards.Reset();
+	for (int32 i = 0; i < rankedGuards.Num(); ++i)
+	{
+		AGuard* guard = rankedGuards[i].Value;
+		const bool bGranted = i < MaxActiveChaseSlots;
+		if (bGranted)
+			ChaseSlotGuards.Add(guard);
+
+		guard->SetChaseSlotGranted(bGranted);
+		if (!bGranted)
+			guard->SetChaseConvergeLocation(LastKnownPlayerLocation);
+	}
+}
+
 ACatastropheMainGameMode* ACatastropheMainGameMode::GetGameModeInst(const UObject* _worldContextObject)
 {
 	if (AGameModeBase* gamemode = UGameplayStatics::GetGameMode(_worldContextObject))
@@ -204,3 +279,9 @@ void ACatastropheMainGameMode::Cheat_Teleport(const FString& _levelName, const F
 	}
 	//CatastropheDebug::OnScreenDebugMsg(-1, 10.0f, FColor::Cyan, enumName);
 }
+
+void ACatastropheMainGameMode::Debug_StreamingStats()
+{
+	if (UStreamingTelemetrySubsystem* telemetry = UStreamingTelemetrySubsystem::GetInst(this))
+		telemetry->PrintStreamingStats();
+}
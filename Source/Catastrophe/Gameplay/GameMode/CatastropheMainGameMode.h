@@ -46,9 +46,35 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Gameplay | General")
 	class APlayerCharacter* PlayerCharacter;
 
-	/** Array of guards thats chasing the player */
+	/** Set of guards thats chasing the player */
 	UPROPERTY(BlueprintReadWrite, Category = "Gameplay | General")
-	TArray<AActor*> ChasingGuards;
+	TSet<AActor*> ChasingGuards;
+
+	/** Guards thats currently holding a full cost chase slot, always a subset of ChasingGuards */
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay | Chase")
+	TSet<AActor*> ChaseSlotGuards;
+
+	/** Maximum number of guards that can run the full cost chase behaviour at the same time */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gameplay | Chase")
+	int32 MaxActiveChaseSlots = 3;
+
+	/** How often the chase slots get re-ranked while any guard is chasing */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gameplay | Chase")
+	float ChaseSlotUpdateInterval = 0.5f;
+
+	/**
+	 * Extra distance added onto a guard's rank when it has no sight on the player
+	 * @note Larger value means guards with sight are more likely to get the slots
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Gameplay | Chase")
+	float NoSightRankPenalty = 2000.0f;
+
+	/** The last known location of the player shared by all chasing guards */
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay | Chase")
+	FVector LastKnownPlayerLocation;
+
+	/** Timer handle for the chase slot ranking */
+	FTimerHandle ChaseSlotTimerHandle;
 
 	/** The class reference to the QTE event */
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay | QTE_Bob")
@@ -120,6 +146,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay | General")
 	void RemoveOneChasingGuard(AActor* _guard);
 
+	/**
+	 * Check if the guard is currently holding one of the full cost chase slot
+	 * @author Richard Wulansari
+	 * @param _guard The guard reference
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gameplay | Chase")
+	bool HasChaseSlot(AActor* _guard) const;
+
 	/**
 	 * Initiate the qte event which will involve the guard and the player character
 	 * This will spawn the AQteBobLogicHolder and set the QteGuard as involved guard
@@ -160,6 +194,7 @@ public:
 	/** Getter */
 	FORCEINLINE class ACaveCameraTrack* GetCaveCameraTrack() const { 
 		return CaveCameraTrack; }
+	FORCEINLINE int32 GetChasingGuardCount() const { return ChasingGuards.Num(); }
 
 	/** Getter End */
 
@@ -196,6 +231,13 @@ private:
 	 */
 	void OnGuardQteFailed();
 
+	/**
+	 * Ranks all the chasing guards by distance and sight on the player
+	 * then hands out the limited chase slots to the best ranked ones
+	 * @author Richard Wulansari
+	 */
+	void UpdateChaseSlots();
+
 
 public:
 	/**
@@ -219,6 +261,10 @@ protected:
 	UFUNCTION(Exec)
 	virtual void Cheat_Teleport(const FString& _levelName, const FString& _districtName);
 
+	/** Prints the load time percentiles of each district */
+	UFUNCTION(Exec)
+	virtual void Debug_StreamingStats();
+
 
 
 
@@ -6,9 +6,9 @@
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/ArrowComponent.h"
-#include "GameFramework/Controller.h"
 
 #include "Interactable/BaseClasses/InteractableComponent.h"
+#include "Components/TraversalComponent.h"
 #include "Characters/PlayerCharacter/PlayerCharacter.h"
 
 // Sets default values
@@ -38,11 +38,13 @@ AVentilationShortcut::AVentilationShortcut()
 	TeleportArrow->SetupAttachment(TeleportTransformComponent);
 
 	InteractComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractComponent"));
-	InteractComponent->RegisterTriggerVolume(TriggerBox);
+	InteractComponent->RegisterTriggerVolume(TriggerBox, true);
 	InteractComponent->OnPlayerEnterInteractRange.RemoveDynamic(this, &AVentilationShortcut::OnPlayerEnterInteractRange);
 	InteractComponent->OnPlayerEnterInteractRange.AddDynamic(this, &AVentilationShortcut::OnPlayerEnterInteractRange);
 	InteractComponent->OnInteractSuccess.RemoveDynamic(this, &AVentilationShortcut::OnInteractSuccess);
 	InteractComponent->OnInteractSuccess.AddDynamic(this, &AVentilationShortcut::OnInteractSuccess);
+
+	TraversalComponent = CreateDefaultSubobject<UTraversalComponent>(TEXT("TraversalComponent"));
 }
 
 void AVentilationShortcut::OnPlayerEnterInteractRange(class APlayerCharacter* _playerCharacter)
@@ -58,10 +60,10 @@ void AVentilationShortcut::OnInteractSuccess(class APlayerCharacter* _playerChar
 	}
 	else
 	{
-		FVector teleportLocation = TeleportTransformComponent->GetComponentLocation();
-		FRotator teleportRotation = TeleportTransformComponent->GetComponentRotation();
-		_playerCharacter->SetActorLocationAndRotation(teleportLocation, teleportRotation);
-		_playerCharacter->GetController()->SetControlRotation(teleportRotation);
+		TraversalComponent->TeleportCharacter(_playerCharacter,
+			TeleportTransformComponent->GetComponentLocation(),
+			TeleportTransformComponent->GetComponentRotation(),
+			false);
 	}
 }
 
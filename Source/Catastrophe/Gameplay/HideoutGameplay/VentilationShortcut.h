@@ -31,6 +31,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ventilation", meta = (AllowPrivateAccess = "true"))
 	class UInteractableComponent* InteractComponent;
 
+	/** Moves the player to the other end of the vent */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ventilation", meta = (AllowPrivateAccess = "true"))
+	class UTraversalComponent* TraversalComponent;
+
 protected:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ventilation")
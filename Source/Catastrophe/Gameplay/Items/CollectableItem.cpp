@@ -28,7 +28,7 @@ ACollectableItem::ACollectableItem()
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
 	InteractableComponent->bAutoInteract = false;
-	InteractableComponent->RegisterTriggerVolume(TriggerVolume);
+	InteractableComponent->RegisterTriggerVolume(TriggerVolume, true);
 	InteractableComponent->OnInteractSuccess.RemoveDynamic(this, &ACollectableItem::OnInteractSuccess);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &ACollectableItem::OnInteractSuccess);
 	InteractableComponent->InteractionDescriptionText = TEXT("Collect");
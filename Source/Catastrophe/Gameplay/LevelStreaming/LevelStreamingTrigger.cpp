@@ -5,6 +5,7 @@
 
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/SphereComponent.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -30,6 +31,27 @@ ALevelStreamingTrigger::ALevelStreamingTrigger()
 	EditorOnlyMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	EditorOnlyMesh->SetGenerateOverlapEvents(false);
 	EditorOnlyMesh->SetupAttachment(TriggerBox);
+
+	PrefetchSphere = CreateDefaultSubobject<USphereComponent>(TEXT("PrefetchSphere"));
+	PrefetchSphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	PrefetchSphere->SetCollisionProfileName(TEXT("Trigger"));
+	PrefetchSphere->SetSphereRadius(PrefetchDistance);
+	PrefetchSphere->OnComponentBeginOverlap.RemoveDynamic(this, &ALevelStreamingTrigger::OnPlayerEnterPrefetchArea);
+	PrefetchSphere->OnComponentBeginOverlap.AddDynamic(this, &ALevelStreamingTrigger::OnPlayerEnterPrefetchArea);
+	PrefetchSphere->OnComponentEndOverlap.RemoveDynamic(this, &ALevelStreamingTrigger::OnPlayerLeavePrefetchArea);
+	PrefetchSphere->OnComponentEndOverlap.AddDynamic(this, &ALevelStreamingTrigger::OnPlayerLeavePrefetchArea);
+	PrefetchSphere->SetupAttachment(TriggerBox);
+
+	// The prefetch distance should not follow the scale of the trigger box
+	PrefetchSphere->SetAbsolute(false, false, true);
+}
+
+void ALevelStreamingTrigger::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	PrefetchSphere->SetSphereRadius(PrefetchDistance);
+	PrefetchSphere->SetGenerateOverlapEvents(bPrefetchDestination);
 }
 
 // Called when the game starts or when spawned
@@ -39,6 +61,14 @@ void ALevelStreamingTrigger::BeginPlay()
 
 }
 
+void ALevelStreamingTrigger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	// Do not keep the destination loaded for a trigger that is gone
+	SetPrefetching(false);
+}
+
 // Called when trigger collides
 void ALevelStreamingTrigger::OnPlayerEnterTrigger(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
@@ -47,4 +77,39 @@ void ALevelStreamingTrigger::OnPlayerEnterTrigger(class UPrimitiveComponent* Ove
 		URespawnSubsystem::GetInst(this)->RespawnPlayerAtDistrict(
 			DestinationLevelDistrict, RespawnLocationName);
 	}
-}
\ No newline at end of file
+}
+
+void ALevelStreamingTrigger::OnPlayerEnterPrefetchArea(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (OtherActor->ActorHasTag(TEXT("Player")) && bActive && bPrefetchDestination)
+	{
+		SetPrefetching(true);
+	}
+}
+
+void ALevelStreamingTrigger::OnPlayerLeavePrefetchArea(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (OtherActor->ActorHasTag(TEXT("Player")))
+	{
+		SetPrefetching(false);
+	}
+}
+
+void ALevelStreamingTrigger::SetPrefetching(bool _bPrefetching)
+{
+	if (bPrefetching == _bPrefetching) return;
+
+	URespawnSubsystem* respawnSubsystem = URespawnSubsystem::GetInst(this);
+	if (!respawnSubsystem) return;
+
+	// A skipped prefetch holds nothing, so there is nothing to release later
+	if (_bPrefetching)
+	{
+		bPrefetching = respawnSubsystem->PrefetchDistrict(DestinationLevelDistrict);
+	}
+	else
+	{
+		bPrefetching = false;
+		respawnSubsystem->ReleasePrefetchedDistrict(DestinationLevelDistrict);
+	}
+}
@@ -22,6 +22,13 @@ private:
 
 	UPROPERTY(VisibleAnywhere, meta = (AllowPrivateAccess = "true"))
 	class UStaticMeshComponent* EditorOnlyMesh;
+
+	/** The area the destination district is prefetched in */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class USphereComponent* PrefetchSphere;
+
+	/** True while this trigger holds a prefetch of the destination district */
+	bool bPrefetching = false;
 	
 public:	
 	// Sets default values for this actor's properties
@@ -39,19 +46,51 @@ protected:
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Respawn System")
 	FString RespawnLocationName = TEXT("Default Name");
 
+	/** If true, the destination district is loaded in the background when the player comes near */
+	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Respawn System")
+	bool bPrefetchDestination = true;
+
+	/** The distance from the trigger the destination district starts loading at */
+	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Respawn System", meta = (EditCondition = "bPrefetchDestination", ClampMin = "0.0"))
+	float PrefetchDistance = 3000.0f;
+
 public:
 
 	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
 	bool bActive = true;
 
 protected:
+	virtual void OnConstruction(const FTransform& Transform) override;
+
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Called when the game ends
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * Called when trigger collides
 	 * @author Richard Wulansari
 	 */
 	UFUNCTION()
 	void OnPlayerEnterTrigger(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/**
+	 * Called when the player comes near, starts the prefetch of the destination district
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION()
+	void OnPlayerEnterPrefetchArea(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/**
+	 * Called when the player walks away, releases the prefetch of the destination district
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION()
+	void OnPlayerLeavePrefetchArea(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+private:
+
+	/** Starts or releases the prefetch of the destination district */
+	void SetPrefetching(bool _bPrefetching);
 };
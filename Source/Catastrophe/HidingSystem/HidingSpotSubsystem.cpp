@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HidingSpotSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+UHidingSpotSubsystem::UHidingSpotSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UHidingSpotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+}
+
+void UHidingSpotSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	HidingSpots.Empty();
+	FreeSpotIndices.Empty();
+	ActorToSpotIndex.Empty();
+	Grid.Empty();
+}
+
+void UHidingSpotSubsystem::RegisterHidingSpot(AActor* _hidingActor)
+{
+	if (!IsValid(_hidingActor) || ActorToSpotIndex.Contains(_hidingActor))
+		return;
+
+	FHidingSpotInfo newSpot;
+	newSpot.HidingActor = _hidingActor;
+	newSpot.Location = _hidingActor->GetActorLocation();
+	newSpot.Cell = GetCellFromLocation(newSpot.Location);
+
+	// Reuse a hole left by a removed spot if there is one
+	int32 spotIndex;
+	if (FreeSpotIndices.Num() > 0)
+	{
+		spotIndex = FreeSpotIndices.Pop(false);
+		HidingSpots[spotIndex] = newSpot;
+	}
+	else
+	{
+		spotIndex = HidingSpots.Add(newSpot);
+	}
+
+	ActorToSpotIndex.Add(_hidingActor, spotIndex);
+	Grid.FindOrAdd(newSpot.Cell).Add(spotIndex);
+}
+
+void UHidingSpotSubsystem::UnregisterHidingSpot(AActor* _hidingActor)
+{
+	int32 spotIndex;
+	if (!ActorToSpotIndex.RemoveAndCopyValue(_hidingActor, spotIndex))
+		return;
+
+	const FIntPoint cell = HidingSpots[spotIndex].Cell;
+	if (TArray<int32>* cellSpots = Grid.Find(cell))
+	{
+		cellSpots->RemoveSwap(spotIndex);
+		if (cellSpots->Num() == 0)
+			Grid.Remove(cell);
+	}
+
+	HidingSpots[spotIndex] = FHidingSpotInfo();
+	FreeSpotIndices.Add(spotIndex);
+}
+
+void UHidingSpotSubsystem::SetHidingSpotOccupied(AActor* _hidingActor, bool _bOccupied)
+{
+	if (FHidingSpotInfo* hidingSpot = FindHidingSpot(_hidingActor))
+		hidingSpot->bOccupied = _bOccupied;
+}
+
+bool UHidingSpotSubsystem::IsHidingSpotOccupied(AActor* _hidingActor) const
+{
+	const FHidingSpotInfo* hidingSpot = FindHidingSpot(_hidingActor);
+	return hidingSpot && hidingSpot->bOccupied;
+}
+
+void UHidingSpotSubsystem::MarkHidingSpotChecked(AActor* _hidingActor)
+{
+	if (FHidingSpotInfo* hidingSpot = FindHidingSpot(_hidingActor))
+		hidingSpot->LastCheckedTime = _hidingActor->GetWorld()->GetTimeSeconds();
+}
+
+void UHidingSpotSubsystem::FindNearestUncheckedHidingSpots(const AActor* _searcher, float _searchRadius, int32 _maxCount, TArray<AActor*>& _outHidingSpots) const
+{
+	_outHidingSpots.Reset();
+	if (!IsValid(_searcher) || _maxCount <= 0)
+		return;
+
+	const FVector searchCenter = _searcher->GetActorLocation();
+	const float radiusSquared = FMath::Square(_searchRadius);
+	const float currentTime = _searcher->GetWorld()->GetTimeSeconds();
+
+	// Only visit the cells overlapping the search radius
+	const FIntPoint minCell = GetCellFromLocation(searchCenter - FVector(_searchRadius));
+	const FIntPoint maxCell = GetCellFromLocation(searchCenter + FVector(_searchRadius));
+
+	TArray<TPair<float, int32>> candidates;
+	for (int32 y = minCell.Y; y <= maxCell.Y; ++y)
+	{
+		for (int32 x = minCell.X; x <= maxCell.X; ++x)
+		{
+			const TArray<int32>* cellSpots = Grid.Find(FIntPoint(x, y));
+			if (!cellSpots)
+				continue;
+
+			for (int32 spotIndex : *cellSpots)
+			{
+				const FHidingSpotInfo& hidingSpot = HidingSpots[spotIndex];
+				if (currentTime - hidingSpot.LastCheckedTime < RecheckCooldown)
+					continue;
+
+				const float distSquared = FVector::DistSquared(searchCenter, hidingSpot.Location);
+				if (distSquared <= radiusSquared)
+					candidates.Emplace(distSquared, spotIndex);
+			}
+		}
+	}
+
+	candidates.Sort([](const TPair<float, int32>& _a, const TPair<float, int32>& _b)
+	{
+		return _a.Key < _b.Key;
+	});
+
+	for (const TPair<float, int32>& candidate : candidates)
+	{
+		if (_outHidingSpots.Num() >= _maxCount)
+			break;
+
+		if (AActor* hidingActor = HidingSpots[candidate.Value].HidingActor.Get())
+			_outHidingSpots.Add(hidingActor);
+	}
+}
+
+FIntPoint UHidingSpotSubsystem::GetCellFromLocation(const FVector& _location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(_location.X / GridCellSize),
+		FMath::FloorToInt(_location.Y / GridCellSize));
+}
+
+FHidingSpotInfo* UHidingSpotSubsystem::FindHidingSpot(AActor* _hidingActor)
+{
+	const int32* spotIndex = ActorToSpotIndex.Find(_hidingActor);
+	return spotIndex ? &HidingSpots[*spotIndex] : nullptr;
+}
+
+const FHidingSpotInfo* UHidingSpotSubsystem::FindHidingSpot(AActor* _hidingActor) const
+{
+	const int32* spotIndex = ActorToSpotIndex.Find(_hidingActor);
+	return spotIndex ? &HidingSpots[*spotIndex] : nullptr;
+}
+
+UHidingSpotSubsystem* UHidingSpotSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UHidingSpotSubsystem>();
+	}
+	return nullptr;
+}
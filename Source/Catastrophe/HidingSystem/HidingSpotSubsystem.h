@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "HidingSpotSubsystem.generated.h"
+
+/**
+ * The information of a registered hiding spot
+ */
+USTRUCT(BlueprintType)
+struct FHidingSpotInfo
+{
+	GENERATED_BODY()
+
+public:
+
+	/** The actor the player hides in */
+	UPROPERTY()
+	TWeakObjectPtr<AActor> HidingActor;
+
+	/** Cached location of the actor, hiding spots does not move */
+	UPROPERTY(BlueprintReadOnly)
+	FVector Location;
+
+	/** The cell of the grid this spot is in */
+	UPROPERTY()
+	FIntPoint Cell;
+
+	/** Is the player hiding in this spot */
+	UPROPERTY(BlueprintReadOnly)
+	bool bOccupied;
+
+	/** World time when a guard last checked this spot */
+	UPROPERTY(BlueprintReadOnly)
+	float LastCheckedTime;
+
+	FHidingSpotInfo() :
+		HidingActor(nullptr),
+		Location(0.0f, 0.0f, 0.0f),
+		Cell(0, 0),
+		bOccupied(false),
+		LastCheckedTime(-BIG_NUMBER)
+	{}
+};
+
+/**
+ * This system keeps track of all the hiding spots of the loaded levels in a grid
+ * So the searching guards can look for the nearest hiding spots without scanning actors
+ */
+UCLASS()
+class CATASTROPHE_API UHidingSpotSubsystem : public UCatastropheGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UHidingSpotSubsystem();
+
+protected:
+
+	/** The size of each cell of the grid */
+	float GridCellSize = 1000.0f;
+
+	/** Time before a checked hiding spot is worth checking again */
+	float RecheckCooldown = 15.0f;
+
+	/** All the registered hiding spots, removed spots leave a hole that gets reused */
+	UPROPERTY()
+	TArray<FHidingSpotInfo> HidingSpots;
+
+	/** Indices of the holes in HidingSpots */
+	TArray<int32> FreeSpotIndices;
+
+	/** Finds the index of the hiding spot from the actor */
+	TMap<TWeakObjectPtr<AActor>, int32> ActorToSpotIndex;
+
+	/** The spatial grid, each cell stores the index of the hiding spots inside */
+	TMap<FIntPoint, TArray<int32>> Grid;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Registers an actor as a hiding spot
+	 * @author Richard Wulansari
+	 * @param _hidingActor The actor the player can hide in
+	 * @note Call this at BeginPlay, the location is cached so the actor should not move
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HidingSystem")
+	void RegisterHidingSpot(AActor* _hidingActor);
+
+	/**
+	 * Removes an actor from the registered hiding spots
+	 * @author Richard Wulansari
+	 * @param _hidingActor The actor to remove
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HidingSystem")
+	void UnregisterHidingSpot(AActor* _hidingActor);
+
+	/**
+	 * Sets if the player is hiding in the spot
+	 * @author Richard Wulansari
+	 * @param _hidingActor The registered hiding spot
+	 * @param _bOccupied Is the player in it
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HidingSystem")
+	void SetHidingSpotOccupied(AActor* _hidingActor, bool _bOccupied);
+
+	/**
+	 * Check if the player is hiding in the spot
+	 * @author Richard Wulansari
+	 * @param _hidingActor The registered hiding spot
+	 */
+	UFUNCTION(BlueprintPure, Category = "HidingSystem")
+	bool IsHidingSpotOccupied(AActor* _hidingActor) const;
+
+	/**
+	 * Marks the hiding spot as checked by a guard, so it will not be searched again for a while
+	 * @author Richard Wulansari
+	 * @param _hidingActor The registered hiding spot
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HidingSystem")
+	void MarkHidingSpotChecked(AActor* _hidingActor);
+
+	/**
+	 * Gets the nearest hiding spots that has not been checked recently
+	 * @author Richard Wulansari
+	 * @param _searcher The actor searching, its location is used as the center
+	 * @param _searchRadius Spots further than this are ignored
+	 * @param _maxCount Maximum number of spots to return
+	 * @param _outHidingSpots The spots sorted from the nearest
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HidingSystem")
+	void FindNearestUncheckedHidingSpots(const AActor* _searcher, float _searchRadius, int32 _maxCount, TArray<AActor*>& _outHidingSpots) const;
+
+	/** Gets the instance without going through the GameInstance */
+	static UHidingSpotSubsystem* GetInst(const UObject* _worldContextObject);
+
+private:
+
+	/** Gets the grid cell of a world location */
+	FIntPoint GetCellFromLocation(const FVector& _location) const;
+
+	/** Gets the registered hiding spot of the actor, nullptr if not registered */
+	FHidingSpotInfo* FindHidingSpot(AActor* _hidingActor);
+	const FHidingSpotInfo* FindHidingSpot(AActor* _hidingActor) const;
+
+};
@@ -5,145 +5,241 @@
 
 #include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/SphereComponent.h"
 
 #include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 #include "Characters/PlayerCharacter/PlayerCharacter.h"
 #include "Characters/PlayerCharacter/PlayerWidget.h"
+#include "Characters/PlayerCharacter/PlayerHudModel.h"
+#include "InteractionSystem/InteractionSubsystem.h"
+#include "RespawnSystem/PostLoadInitSubsystem.h"
 
 
 // Sets default values for this component's properties
 UInteractableComponent::UInteractableComponent()
 {
-	// This component will tick
-	PrimaryComponentTick.bCanEverTick = true;
+	// The ui is pushed through the hud model, no need to tick
+	PrimaryComponentTick.bCanEverTick = false;
 
 }
 
-void UInteractableComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UInteractableComponent::BeginPlay()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	Super::BeginPlay();
 
-	if (HasValidData() && bShowingUi)
+	if (InteractionVolumes.Num() > 0)
 	{
-		PlayerHudRef->UpdateInteractionUi(this);
-
-		if (bCanInteract == false)
+		// Registered after the level has been added, it may have ended play by then
+		UPostLoadInitSubsystem::ScheduleWork(this, [this]()
 		{
-			SetInteractionUiVisible(false);
-		}
+			if (!HasBegunPlay()) return;
+
+			if (UInteractionSubsystem* interactionSystem = UInteractionSubsystem::GetInst(this))
+				interactionSystem->RegisterInteractable(this);
+		});
 	}
 }
 
-// When trigger with the player character, set interaction target to it
-void UInteractableComponent::OnTriggerWithPlayer(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void UInteractableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (OtherActor->ActorHasTag("Player"))
-	{
-		if (!PlayerRef)
-			PlayerRef = Cast<APlayerCharacter>(OtherActor);
+	Super::EndPlay(EndPlayReason);
 
-		if (IsValid(PlayerRef))
-		{
-			PlayerRef->ResetInteractionAction();
-			PlayerHudRef = PlayerRef->GetPlayerHudWidget();
-			TriggerCounter++;
+	if (UInteractionSubsystem* interactionSystem = UInteractionSubsystem::GetInst(this))
+		interactionSystem->UnregisterInteractable(this);
+}
 
-			OnPlayerEnterInteractRange.Broadcast(PlayerRef);
+// When the player comes in range, store the references for the ui
+void UInteractableComponent::OnPlayerEnterRange(class APlayerCharacter* _playerCharacter)
+{
+	PlayerRef = _playerCharacter;
+	if (!IsValid(PlayerRef)) return;
 
-			if (bCanInteract)
-			{
-				PlayerRef->SetInteractionTarget(this);
-				SetInteractionUiVisible(true);
-
-				// If this component has set to auto interact, interact immediatly
-				if (bAutoInteract && IsValid(PlayerRef))
-				{
-					Interact(PlayerRef, 0.0f);
-				}
-			}
-		}
+	PlayerHudRef = PlayerRef->GetPlayerHudWidget();
+	OnPlayerEnterInteractRange.Broadcast(PlayerRef);
+
+	// If this component has set to auto interact, interact immediatly
+	if (bCanInteract && bAutoInteract)
+	{
+		Interact(PlayerRef);
 	}
 }
 
-// As player leaves the trigger area, decrease trigger count and if no more trigger count, disable interaction
-void UInteractableComponent::OnTriggerEndWithPlayer(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+// As player leaves the range, disable interaction
+void UInteractableComponent::OnPlayerExitRange(class APlayerCharacter* _playerCharacter)
+{
+	if (!IsValid(PlayerRef) || PlayerRef != _playerCharacter) return;
+
+	if (PlayerRef->GetInteractingTargetComponent() == this)
+	{
+		PlayerRef->ResetInteractionAction();
+		SetInteractionUiVisible(false);
+	}
+
+	bShowingUi = false;
+	PlayerRef->RemoveInteractionTarget(this);
+	OnPlayerExitInteractRange.Broadcast(PlayerRef);
+}
+
+bool UInteractableComponent::IsPlayerInRange(const FVector& _playerLocation, float _capsuleRadius, float _capsuleHalfHeight) const
 {
-	if (PlayerRef == OtherActor)
+	const FVector capsuleExtent(_capsuleRadius, _capsuleRadius, _capsuleHalfHeight);
+	for (const UPrimitiveComponent* volume : InteractionVolumes)
 	{
-		TriggerCounter--;
-		if (TriggerCounter <= 0)
+		if (!IsValid(volume))
+			continue;
+
+		// Test against the oriented box, the same shape the overlap used to test
+		if (const UBoxComponent* boxVolume = Cast<UBoxComponent>(volume))
 		{
-			HoldingTime = 0.0f;
-			
-			if (PlayerRef->GetInteractingTargetComponent() == this)
+			FTransform boxTransform = boxVolume->GetComponentTransform();
+			boxTransform.RemoveScaling();
+			const FVector localLocation = boxTransform.InverseTransformPositionNoScale(_playerLocation).GetAbs();
+			const FVector boxExtent = boxVolume->GetScaledBoxExtent() + capsuleExtent;
+			if (localLocation.X <= boxExtent.X &&
+				localLocation.Y <= boxExtent.Y &&
+				localLocation.Z <= boxExtent.Z)
 			{
-				PlayerRef->ResetInteractionAction();
-				SetInteractionUiVisible(false);
+				return true;
 			}
-
-			bShowingUi = false;
-			PlayerRef->RemoveInteractionTarget(this);
-			OnPlayerExitInteractRange.Broadcast(PlayerRef);
 		}
+		else if (const USphereComponent* sphereVolume = Cast<USphereComponent>(volume))
+		{
+			const float reach = sphereVolume->GetScaledSphereRadius() + _capsuleRadius;
+			if (FVector::DistSquared(sphereVolume->GetComponentLocation(), _playerLocation) <= FMath::Square(reach))
+				return true;
+		}
+		else if (volume->Bounds.GetBox().ExpandBy(capsuleExtent).IsInside(_playerLocation))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+float UInteractableComponent::GetInteractionReach() const
+{
+	const FVector ownerLocation = GetOwner()->GetActorLocation();
+	float reach = 0.0f;
+	for (const UPrimitiveComponent* volume : InteractionVolumes)
+	{
+		if (IsValid(volume))
+			reach = FMath::Max(reach, FVector::Dist(ownerLocation, volume->Bounds.Origin) + volume->Bounds.SphereRadius);
 	}
+	return reach;
 }
 
 // Called when the player interact with this component
-void UInteractableComponent::Interact(class APlayerCharacter* _playerCharacter, float _holdTime)
+void UInteractableComponent::Interact(class APlayerCharacter* _playerCharacter)
 {
 	if (!HasValidData()) return;
 
-	if (bCanInteract)
+	if (bCanInteract && !bInteracting)
 	{
-		HoldingTime = _holdTime;
+		bInteracting = true;
+		HoldingTime = 0.0f;
+		HoldStartTime = GetWorld()->GetTimeSeconds();
+		OnInteractTickBegin.Broadcast(_playerCharacter);
+		RefreshInteractionUi();
 
-		// Check if this is the beginning of the interaction
-		if (!bInteracting)
+		// The completion is scheduled once, the hud interpolates the progress with GetHoldProgress
+		if (RequiredHoldTime > 0.0f)
 		{
-			bInteracting = true;
-			OnInteractTickBegin.Broadcast(_playerCharacter);
-		}
+			GetWorld()->GetTimerManager().SetTimer(HoldTimerHandle, this, &UInteractableComponent::CompleteInteract, RequiredHoldTime, false);
 
-		// Check if player has completed the holding time requirement
-		if (_holdTime >= RequiredHoldTime)
-		{
-			OnInteractSuccess.Broadcast(_playerCharacter);
-
-			// After a successful interaction
-			HoldingTime = 0.0f;
-			bInteracting = false;
-			_playerCharacter->ResetInteractionAction();
-
-			// If the component has set to one time use, disable after interaction
-			if (bOneTimeUse)
-			{
-				bCanInteract = false;
-				SetInteractionUiVisible(false);
-			}
+			// Blueprints bound to the tick event still get it, at a fixed rate instead of every frame
+			GetWorld()->GetTimerManager().SetTimer(InteractTickTimerHandle, this, &UInteractableComponent::BroadcastInteractTick, FMath::Max(InteractTickInterval, 0.01f), true, 0.0f);
 		}
-		else // If not, then broadcast the holding event
+		else
 		{
-			OnInteractTick.Broadcast(_playerCharacter, _holdTime);
+			CompleteInteract();
 		}
 	}
 }
 
 void UInteractableComponent::StopInteract()
 {
+	// Only cancel if the hold has not completed yet
+	if (!bInteracting) return;
+
+	bInteracting = false;
+	HoldingTime = 0.0f;
+	GetWorld()->GetTimerManager().ClearTimer(HoldTimerHandle);
+	GetWorld()->GetTimerManager().ClearTimer(InteractTickTimerHandle);
+	OnInteractCancel.Broadcast(PlayerRef);
+	RefreshInteractionUi();
+}
+
+void UInteractableComponent::CompleteInteract()
+{
+	bInteracting = false;
 	HoldingTime = 0.0f;
+	GetWorld()->GetTimerManager().ClearTimer(InteractTickTimerHandle);
+	if (!HasValidData() || !bCanInteract) return;
+
+	OnInteractSuccess.Broadcast(PlayerRef);
+	RefreshInteractionUi();
+
+	// After a successful interaction
+	PlayerRef->ResetInteractionAction();
+
+	// If the component has set to one time use, disable after interaction
+	if (bOneTimeUse)
+	{
+		bCanInteract = false;
+		SetInteractionUiVisible(false);
+	}
+}
+
+void UInteractableComponent::BroadcastInteractTick()
+{
+	if (!bInteracting)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(InteractTickTimerHandle);
+		return;
+	}
+
+	HoldingTime = GetHoldingTime();
+	OnInteractTick.Broadcast(PlayerRef, HoldingTime);
+}
+
+float UInteractableComponent::GetHoldingTime() const
+{
+	return bInteracting ? GetWorld()->GetTimeSeconds() - HoldStartTime : 0.0f;
 }
 
-void UInteractableComponent::RegisterTriggerVolume(class UPrimitiveComponent* _registeringComponent)
+float UInteractableComponent::GetHoldProgress() const
 {
-	// Force the component to generate overlap events
-	_registeringComponent->SetGenerateOverlapEvents(true);
+	if (!bInteracting) return 0.0f;
+	return RequiredHoldTime > 0.0f ? FMath::Clamp(GetHoldingTime() / RequiredHoldTime, 0.0f, 1.0f) : 1.0f;
+}
 
-	// Binds the function to the component event
-	_registeringComponent->OnComponentBeginOverlap.AddDynamic(
-		this, &UInteractableComponent::OnTriggerWithPlayer);
-	_registeringComponent->OnComponentEndOverlap.AddDynamic(
-		this, &UInteractableComponent::OnTriggerEndWithPlayer);
+void UInteractableComponent::RegisterTriggerVolume(class UPrimitiveComponent* _registeringComponent, bool _bInteractionOnly)
+{
+	if (!_registeringComponent) return;
+
+	// The range is queried by the interaction system, so a pure interaction volume does not need to be in the physics scene
+	if (_bInteractionOnly)
+	{
+		_registeringComponent->SetGenerateOverlapEvents(false);
+		_registeringComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+
+	InteractionVolumes.AddUnique(_registeringComponent);
+
+	// Volumes registered from blueprints after begin play, the system has to pick up the new reach and cell
+	if (HasBegunPlay())
+	{
+		if (UInteractionSubsystem* interactionSubsystem = UInteractionSubsystem::GetInst(this))
+		{
+			interactionSubsystem->UnregisterInteractable(this);
+			interactionSubsystem->RegisterInteractable(this);
+		}
+	}
 }
 
 // Sets the visibility of the player interaction ui
@@ -152,8 +248,20 @@ void UInteractableComponent::SetInteractionUiVisible(bool _visibility)
 	if (!HasValidData()) return;
 
 	bShowingUi = _visibility;
-	PlayerHudRef->UpdateInteractionUi(this);
-	PlayerHudRef->SetInteractionUiVisible(_visibility);
+	if (UPlayerHudModel* hudModel = PlayerRef->GetHudModel())
+	{
+		// Only hide if this is still the one being shown
+		if (_visibility || hudModel->GetInteractionTarget() == this)
+			hudModel->SetInteraction(this, _visibility);
+	}
+}
+
+void UInteractableComponent::RefreshInteractionUi()
+{
+	if (!HasValidData() || !bShowingUi) return;
+
+	if (UPlayerHudModel* hudModel = PlayerRef->GetHudModel())
+		hudModel->MarkDirty(EHudSection::Interaction);
 }
 
 bool UInteractableComponent::HasValidData()
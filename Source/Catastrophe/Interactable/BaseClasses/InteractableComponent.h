@@ -38,7 +38,11 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FInteractSingature OnInteractSuccess;
 
-	/** Event called during player interact with this component */
+	/** Event called when the player stops holding before the interaction completes */
+	UPROPERTY(BlueprintAssignable)
+	FInteractSingature OnInteractCancel;
+
+	/** Event called during player interact with this component, broadcasted at InteractTickInterval instead of every frame */
 	UPROPERTY(BlueprintAssignable)
 	FInteractTickSingature OnInteractTick;
 
@@ -46,14 +50,14 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Interaction")
 	bool bCanInteract = true;
 
-	/** Internal calculation use, indicates the player interaction holding time on this object */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	float HoldingTime = 0.0f;
-
 	/** The require holding time of the interaction button in order to interact with this object */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Interaction")
 	float RequiredHoldTime = 0.0f;
 
+	/** Time between each OnInteractTick broadcast while the player is holding the interaction */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Interaction")
+	float InteractTickInterval = 0.1f;
+
 	/** Text that describe the action in order to complete this interaction */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
 	FString InteractionActionText = "Press";
@@ -72,9 +76,9 @@ public:
 
 protected:
 
-	/** Multi-trigger volume support which keep tracking how many trigger is overlapping the player */
+	/** The volumes that define the interaction range, they do not generate overlaps */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	int32 TriggerCounter = 0;
+	TArray<class UPrimitiveComponent*> InteractionVolumes;
 
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Interaction")
 	class APlayerCharacter* PlayerRef;
@@ -85,48 +89,102 @@ protected:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "Interaction")
 	bool bInteracting = false;
 
+	/**
+	 * Internal calculation use, indicates the player interaction holding time on this object
+	 * Blueprints reading it get the holding time of now through the getter
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintGetter = GetHoldingTime, Category = "Interaction")
+	float HoldingTime = 0.0f;
+
 private:
 
 	bool bShowingUi = false;
 
+	/** World time when the player started holding the interaction */
+	float HoldStartTime = 0.0f;
+
+	/** Timer handle that completes the hold interaction */
+	FTimerHandle HoldTimerHandle;
+
+	/** Timer handle that broadcasts OnInteractTick during the hold interaction */
+	FTimerHandle InteractTickTimerHandle;
+
 protected:
 
-	/** Called when registered component overlap event triggers */
-	UFUNCTION()
-	void OnTriggerWithPlayer(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	/** Called when the game starts */
+	virtual void BeginPlay() override;
 
-	/** Called when registered component end overlap event triggers*/
-	UFUNCTION()
-	void OnTriggerEndWithPlayer(class UPrimitiveComponent* OverlappedComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	/** Called when the game ends */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 
-	/** Called each frame */
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	/**
+	 * Called by the interaction system when the player enters the interaction range
+	 * @author Richard Wulansari
+	 * @param _playerCharacter
+	 */
+	void OnPlayerEnterRange(class APlayerCharacter* _playerCharacter);
 
 	/**
-	 * Called when the player interact with this component
-	 * @author Richard Wulasnsari
+	 * Called by the interaction system when the player exits the interaction range
+	 * @author Richard Wulansari
 	 * @param _playerCharacter
-	 * @param _holdTime: How long has the player been holding interact
 	 */
-	void Interact(class APlayerCharacter* _playerCharacter, float _holdTime);
+	void OnPlayerExitRange(class APlayerCharacter* _playerCharacter);
+
+	/**
+	 * Check if the player capsule is inside any of the interaction volumes
+	 * @author Richard Wulansari
+	 * @param _playerLocation
+	 * @param _capsuleRadius
+	 * @param _capsuleHalfHeight
+	 */
+	bool IsPlayerInRange(const FVector& _playerLocation, float _capsuleRadius, float _capsuleHalfHeight) const;
 
+	/**
+	 * Gets how far the interaction volumes reach from the owner
+	 * @author Richard Wulansari
+	 */
+	float GetInteractionReach() const;
+
+	/**
+	 * Called when the player begins to interact with this component
+	 * @author Richard Wulasnsari
+	 * @param _playerCharacter
+	 * @note Completes immediately if no hold time is required, otherwise completes by timer
+	 */
+	void Interact(class APlayerCharacter* _playerCharacter);
 
 	/**
-	 * Stop the interaction
+	 * Stop the interaction, cancels the hold if it has not completed
 	 * @author Richard Wulasnsari
 	 */
 	void StopInteract();
 
 	/**
-	 * Register a component that has some trigger volume
+	 * Gets how long the player has been holding the interaction
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	float GetHoldingTime() const;
+
+	/**
+	 * Gets the hold progress from 0 to 1, for the hud to interpolate the progress bar
 	 * @author Richard Wulansari
-	 * @param _registeringComponent The component that is receiving the overlap events
-	 * @note This function is prefer to be called in constructor
+	 */
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	float GetHoldProgress() const;
+
+	/**
+	 * Register a component that defines the interaction range
+	 * @author Richard Wulansari
+	 * @param _registeringComponent The volume of the interaction range
+	 * @param _bInteractionOnly True if the volume exists only for the interaction, its collision will be disabled
+	 * @note This function is prefer to be called in constructor, volumes used for anything else keep their collision
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Interaction")
-	void RegisterTriggerVolume(class UPrimitiveComponent* _registeringComponent);
+	void RegisterTriggerVolume(class UPrimitiveComponent* _registeringComponent, bool _bInteractionOnly = false);
 
 	/**
 	 * Sets the visiblity of the player interaction Ui
@@ -135,6 +193,18 @@ public:
 	 */
 	void SetInteractionUiVisible(bool _visibility);
 
+	/**
+	 * Refresh the player interaction ui if it is showing this component, e.g. after the description text has changed
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void RefreshInteractionUi();
+
+	/** Getter */
+	FORCEINLINE bool IsShowingUi() const { return bShowingUi; }
+	FORCEINLINE bool IsInteracting() const { return bInteracting; }
+	/** Getter End */
+
 private:
 
 	/**
@@ -144,4 +214,10 @@ private:
 	 */
 	bool HasValidData();
 
+	/** Called by timer when the hold time requirement is met */
+	void CompleteInteract();
+
+	/** Called by timer during the hold interaction to broadcast OnInteractTick */
+	void BroadcastInteractTick();
+
 };
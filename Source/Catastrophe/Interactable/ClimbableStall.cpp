@@ -6,13 +6,14 @@
 #include "Components/SceneComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Interactable/BaseClasses/InteractableComponent.h"
+#include "Components/TraversalComponent.h"
 
 #include "Characters/PlayerCharacter/PlayerCharacter.h"
 
 AClimbableStall::AClimbableStall()
 {
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// The traversal component only ticks while the player is climbing
+	PrimaryActorTick.bCanEverTick = false;
 
 	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	Mesh->SetGenerateOverlapEvents(false);
@@ -24,11 +25,11 @@ AClimbableStall::AClimbableStall()
 	TriggerBox->SetupAttachment(RootComponent);
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
-	
+
+	TraversalComponent = CreateDefaultSubobject<UTraversalComponent>(TEXT("TraversalComponent"));
 
 
 	// Set the default state
-	WayPointCount = 0;
 	bHasUsed = false;
 	bInUse = false;
 }
@@ -37,77 +38,17 @@ void AClimbableStall::BeginPlay()
 {
 	Super::BeginPlay();
 
-	InteractableComponent->RegisterTriggerVolume(TriggerBox);
+	InteractableComponent->RegisterTriggerVolume(TriggerBox, true);
 	InteractableComponent->OnInteractSuccess.RemoveDynamic(this, &AClimbableStall::InteractionStarting);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &AClimbableStall::InteractionStarting);
+	TraversalComponent->OnTraversalComplete.RemoveDynamic(this, &AClimbableStall::OnTraversalComplete);
+	TraversalComponent->OnTraversalComplete.AddDynamic(this, &AClimbableStall::OnTraversalComplete);
 }
 
-float AClimbableStall::FindTotalDistance()
-{
-	float totalDistanceResult = 0.0f;
-
-	for (int i = 0; i < WayPointArray.Num(); ++i)
-	{
-		if (i == 0)
-		{
-			totalDistanceResult +=
-				FVector::Distance(PlayerReference->GetActorLocation(), WayPointArray[0]->GetComponentLocation());
-			continue;
-		}
-
-		totalDistanceResult +=
-			FVector::Distance(WayPointArray[i - 1]->GetComponentLocation(), WayPointArray[i]->GetComponentLocation());
-	}
-
-	return totalDistanceResult;
-}
-
-void AClimbableStall::Tick(float DeltaTime)
+void AClimbableStall::OnTraversalComplete(class ACharacter* _character)
 {
-	Super::Tick(DeltaTime);
-
-	// Run the check for the interaction
-	if (bHasSetPath && bInUse && !bHasUsed)
-	{
-		bool reachedDestination = false;
-
-		// Increament the time the move
-		LerpDelta += DeltaTime;
-		float alpha = LerpDelta / TimeForCurrentPath;
-
-		float leakTime = 0.0f;
-		if (alpha > 1.0f)
-		{
-			float leakAlpha = alpha - 1.0f;
-			leakTime = leakAlpha / TimeForCurrentPath;
-			alpha = 1.0f;
-			reachedDestination = true;
-		}
-
-		// Move the actor
-		FVector resultLocation;
-		resultLocation = FMath::Lerp(CurrentWayPointLoc, DestinationLoc, alpha);
-		PlayerReference->SetActorLocation(resultLocation);
-
-		// Check if the player has reach the current destination
-		if (reachedDestination)
-		{
-			WayPointCount++;
-			if (WayPointCount >= WayPointArray.Num())
-			{
-				// End the interaction and unlock player movement
-				InteractionEnd();
-			}
-			else
-			{
-				LerpDelta = leakTime; // Reset the lerp delta time and add the leak time onto it
-				CurrentWayPointLoc = DestinationLoc;
-				DestinationLoc = WayPointArray[WayPointCount]->GetComponentLocation();
-				CurrentPathLength = FVector::Distance(CurrentWayPointLoc, DestinationLoc);
-				TimeForCurrentPath = (CurrentPathLength / TotalDistanceTravel) * TotalTransferTime;
-			}
-		}
-	}
+	// End the interaction and unlock player movement
+	InteractionEnd();
 }
 
 void AClimbableStall::InteractionStarting(class APlayerCharacter* _playerCharacter)
@@ -117,21 +58,26 @@ void AClimbableStall::InteractionStarting(class APlayerCharacter* _playerCharact
 	{
 		Recieve_InteractionStart();
 
-		// Set the first way point for the action
-		CurrentWayPointLoc = PlayerReference->GetActorLocation();
-		DestinationLoc = WayPointArray[0]->GetComponentLocation();
-		TotalDistanceTravel = FindTotalDistance();
-		CurrentPathLength = FVector::Distance(CurrentWayPointLoc, DestinationLoc);
-		TimeForCurrentPath = (CurrentPathLength / TotalDistanceTravel) * TotalTransferTime;
-
-		// Initiate the interaction
-		bHasSetPath = true;
-		bInUse = true;
-		LerpDelta = 0.0f;
+		// The path is handed over once, the traversal component moves the player at constant speed
+		TArray<FVector> pathPoints;
+		pathPoints.Reserve(WayPointArray.Num());
+		for (const USceneComponent* wayPoint : WayPointArray)
+		{
+			if (wayPoint)
+				pathPoints.Add(wayPoint->GetComponentLocation());
+		}
 
 		// Disable the player action
 		PlayerReference->DisableInput(UGameplayStatics::GetPlayerController(GetWorld(), 0));
 		PlayerReference->RemoveInteractionTarget(InteractableComponent);
+
+		// Initiate the interaction
+		bInUse = true;
+		if (!TraversalComponent->BeginTraversal(PlayerReference, pathPoints, TotalTransferTime))
+		{
+			bInUse = false;
+			PlayerReference->EnableInput(UGameplayStatics::GetPlayerController(GetWorld(), 0));
+		}
 	}
 }
 
@@ -30,6 +30,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	class UInteractableComponent* InteractableComponent;
 
+	/** Moves the player through the way points */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class UTraversalComponent* TraversalComponent;
+
 public:
 	// Sets default values for this actor's properties
 	AClimbableStall();
@@ -37,9 +41,6 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Interaction")
 	float TotalTransferTime;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	float TotalDistanceTravel;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
 	bool bHasUsed;
 
@@ -50,42 +51,16 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
 	bool bUsable = true;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	bool bInWayPointTransit;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	FVector CurrentWayPointLoc;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	FVector DestinationLoc;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Interaction")
-	int WayPointCount;
-
-	UPROPERTY()
-	bool bHasSetPath;
-
-	UPROPERTY()
-	float CurrentPathLength;
-
-	UPROPERTY()
-	float LerpDelta;
-
-	UPROPERTY()
-	float TimeForCurrentPath;
-
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	/** Finds out the total distance needs to travel as soon as the player interact */
+	/** Called when the player has arrived at the last way point */
 	UFUNCTION()
-	float FindTotalDistance();
+	void OnTraversalComplete(class ACharacter* _character);
 
 public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
 	
 	UFUNCTION()
 	void InteractionStarting(class APlayerCharacter* _playerCharacter);
@@ -15,12 +15,14 @@
 #include "TimerManager.h"
 
 #include "Interactable/BaseClasses/InteractableComponent.h"
+#include "Components/TraversalComponent.h"
 #include "Characters/PlayerCharacter/PlayerCharacter.h"
+#include "HidingSystem/HidingSpotSubsystem.h"
 
 AHidingUrn::AHidingUrn()
 {
-	// Needed this for rotating the interaction text
-	PrimaryActorTick.bCanEverTick = true;
+	// Nothing to do per frame, the player is moved by the traversal component
+	PrimaryActorTick.bCanEverTick = false;
 
 	UrnDestructableMesh = CreateDefaultSubobject<UDestructibleComponent>(TEXT("UrnDestructableMesh"));
 	UrnDestructableMesh->CastShadow = false;
@@ -40,31 +42,32 @@ AHidingUrn::AHidingUrn()
 	BlockVolume->SetupAttachment(RootComponent);
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
-	InteractableComponent->RegisterTriggerVolume(TriggerBox);
+	InteractableComponent->RegisterTriggerVolume(TriggerBox, true);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &AHidingUrn::OnPlayerInteract);
+
+	TraversalComponent = CreateDefaultSubobject<UTraversalComponent>(TEXT("TraversalComponent"));
 }
 
 void AHidingUrn::BeginPlay()
 {
 	Super::BeginPlay();
 
-
+	// Let the guards know where they can search
+	if (UHidingSpotSubsystem* hidingSystem = UHidingSpotSubsystem::GetInst(this))
+		hidingSystem->RegisterHidingSpot(this);
 }
 
 void AHidingUrn::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
+
+	if (UHidingSpotSubsystem* hidingSystem = UHidingSpotSubsystem::GetInst(this))
+		hidingSystem->UnregisterHidingSpot(this);
 	
 	// Clear all the timer handle
 	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
 }
 
-void AHidingUrn::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
-
 void AHidingUrn::OnPlayerInteract(class APlayerCharacter* _playerCharacter)
 {
 	if (!bPlayerIn && bCanInteract)
@@ -81,6 +84,8 @@ void AHidingUrn::JumpIn(class APlayerCharacter* _playerCharacter)
 {
 	// Notify that the player is in
 	bPlayerIn = true;
+	if (UHidingSpotSubsystem* hidingSystem = UHidingSpotSubsystem::GetInst(this))
+		hidingSystem->SetHidingSpotOccupied(this, true);
 
 	// Gives a timer that force player to jump out
 	JumpOutTimerDel.BindUFunction(this, FName("JumpOut"), _playerCharacter);
@@ -93,10 +98,10 @@ void AHidingUrn::JumpIn(class APlayerCharacter* _playerCharacter)
 	TempPlayerInfo.PlayerMaxWalkSpeed = _playerCharacter->GetPlayerDefaultValues().WalkSpeed;
 	TempPlayerInfo.PlayerLocation = _playerCharacter->GetActorLocation();
 
-	// Move the player away somewhere and make him invisible
+	// Move the player away somewhere and make him invisible, he is held in place until jumping out
 	FVector TeleportLocation = this->GetActorLocation();
 	TeleportLocation.Z += 200.0f;
-	_playerCharacter->SetActorLocation(TeleportLocation);
+	TraversalComponent->TeleportCharacter(_playerCharacter, TeleportLocation, true);
 	_playerCharacter->SetActorHiddenInGame(true);
 	_playerCharacter->GetStimulusSourceComponent()->UnregisterFromSense(UAISense_Sight::StaticClass());
 
@@ -120,11 +125,15 @@ void AHidingUrn::JumpOut(class APlayerCharacter* _playerCharacter)
 	// Restore the movement of the player
 	_playerCharacter->SetMovementActionEnable(true);
 	_playerCharacter->GetCharacterMovement()->MaxWalkSpeed = TempPlayerInfo.PlayerMaxWalkSpeed;
-	_playerCharacter->SetActorLocation(TempPlayerInfo.PlayerLocation);
 	_playerCharacter->SetActorHiddenInGame(false);
 	_playerCharacter->GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	TraversalComponent->TeleportCharacter(_playerCharacter, TempPlayerInfo.PlayerLocation, false);
 	_playerCharacter->GetStimulusSourceComponent()->RegisterForSense(UAISense_Sight::StaticClass());
 
+	// The urn is broken after this, so it is no longer a hiding spot
+	if (UHidingSpotSubsystem* hidingSystem = UHidingSpotSubsystem::GetInst(this))
+		hidingSystem->UnregisterHidingSpot(this);
+
 	// Disable the collision of the block volume
 	BlockVolume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
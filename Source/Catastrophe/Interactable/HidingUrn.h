@@ -54,6 +54,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	class UInteractableComponent* InteractableComponent;
 
+	/** Moves the player in and out of the urn */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class UTraversalComponent* TraversalComponent;
+
 public:
 	// Sets default values for this actor's properties
 	AHidingUrn();
@@ -113,9 +117,6 @@ protected:
 	void AllowManualJumpOut();
 
 public:
-	/** Called every tick */
-	virtual void Tick(float DeltaTime) override;
-
 	/** Called when the actor has destroyed */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
@@ -36,7 +36,7 @@ AItemCrate::AItemCrate()
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
 	InteractableComponent->bOneTimeUse = false;
-	InteractableComponent->RegisterTriggerVolume(TriggerVolume);
+	InteractableComponent->RegisterTriggerVolume(TriggerVolume, true);
 }
 
 // Called when the game starts or when spawned
@@ -23,7 +23,7 @@ AItemPickup::AItemPickup()
 	TriggerBox->SetupAttachment(root);
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
-	InteractableComponent->RegisterTriggerVolume(TriggerBox);
+	InteractableComponent->RegisterTriggerVolume(TriggerBox, true);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &AItemPickup::PickUpItem);
 }
 
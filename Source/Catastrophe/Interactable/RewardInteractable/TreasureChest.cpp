@@ -23,7 +23,7 @@ ATreasureChest::ATreasureChest()
 	TriggerBox->SetupAttachment(RootComponent);
 
 	InteractableCompoenent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableCompoenent"));
-	InteractableCompoenent->RegisterTriggerVolume(TriggerBox);
+	InteractableCompoenent->RegisterTriggerVolume(TriggerBox, true);
 	InteractableCompoenent->OnInteractSuccess.AddDynamic(this, &ATreasureChest::OnPlayerInteract);
 }
 
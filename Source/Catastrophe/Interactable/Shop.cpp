@@ -22,7 +22,7 @@ AShop::AShop()
 	TriggerBox->SetupAttachment(root);
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
-	InteractableComponent->RegisterTriggerVolume(TriggerBox);
+	InteractableComponent->RegisterTriggerVolume(TriggerBox, true);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &AShop::Interact);
 }
 
@@ -29,7 +29,7 @@ ATomatoBox::ATomatoBox()
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
 	InteractableComponent->bOneTimeUse = false;
-	InteractableComponent->RegisterTriggerVolume(TriggerVolume);
+	InteractableComponent->RegisterTriggerVolume(TriggerVolume, true);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &ATomatoBox::PickUpTomato);
 }
 
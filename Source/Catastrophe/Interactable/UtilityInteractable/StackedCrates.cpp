@@ -29,7 +29,7 @@ AStackedCrates::AStackedCrates()
 	BlockVolume->SetupAttachment(CratesMesh);
 
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
-	InteractableComponent->RegisterTriggerVolume(TriggerVolume);
+	InteractableComponent->RegisterTriggerVolume(TriggerVolume, true);
 	InteractableComponent->OnInteractSuccess.AddDynamic(this, &AStackedCrates::OnPlayerInteract);
 }
 
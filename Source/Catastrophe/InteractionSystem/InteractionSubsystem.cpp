@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InteractionSubsystem.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+
+#include "Interactable/BaseClasses/InteractableComponent.h"
+#include "Characters/PlayerCharacter/PlayerCharacter.h"
+
+UInteractionSubsystem::UInteractionSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UInteractionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bInitialized = true;
+}
+
+void UInteractionSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	bInitialized = false;
+	Grid.Empty();
+	RegisteredCells.Empty();
+	MovableInteractables.Empty();
+	InRangeInteractables.Empty();
+}
+
+void UInteractionSubsystem::Tick(float DeltaTime)
+{
+	QueryTimer -= DeltaTime;
+	if (QueryTimer > 0.0f)
+		return;
+	QueryTimer = QueryInterval;
+
+	APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(
+		UGameplayStatics::GetPlayerCharacter(GetTickableGameObjectWorld(), 0));
+	if (!IsValid(playerCharacter))
+		return;
+
+	// Same as overlaps, nothing changes while the player has no collision. e.g. hiding in an urn
+	if (!playerCharacter->GetCapsuleComponent()->IsCollisionEnabled())
+		return;
+
+	QueryInteractables(playerCharacter);
+}
+
+bool UInteractionSubsystem::IsTickable() const
+{
+	// The class default object should never tick
+	return bInitialized && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+UWorld* UInteractionSubsystem::GetTickableGameObjectWorld() const
+{
+	UGameInstance* gameInst = Cast<UGameInstance>(GetOuter());
+	return gameInst ? gameInst->GetWorld() : nullptr;
+}
+
+TStatId UInteractionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionSubsystem, STATGROUP_Tickables);
+}
+
+void UInteractionSubsystem::RegisterInteractable(UInteractableComponent* _interactable)
+{
+	if (!IsValid(_interactable) || !IsValid(_interactable->GetOwner()))
+		return;
+
+	// Pawns and physics objects can move away from their cell, they are tested on every query instead
+	AActor* owner = _interactable->GetOwner();
+	UPrimitiveComponent* ownerRoot = Cast<UPrimitiveComponent>(owner->GetRootComponent());
+	if (owner->IsA<APawn>() ||
+		(ownerRoot && ownerRoot->IsSimulatingPhysics()))
+	{
+		MovableInteractables.AddUnique(_interactable);
+		return;
+	}
+
+	if (RegisteredCells.Contains(_interactable))
+		return;
+
+	const FIntPoint cell = GetCellFromLocation(owner->GetActorLocation());
+	Grid.FindOrAdd(cell).Add(_interactable);
+	RegisteredCells.Add(_interactable, cell);
+	MaxStaticReach = FMath::Max(MaxStaticReach, _interactable->GetInteractionReach());
+}
+
+void UInteractionSubsystem::UnregisterInteractable(UInteractableComponent* _interactable)
+{
+	MovableInteractables.RemoveSwap(_interactable);
+
+	FIntPoint cell;
+	if (RegisteredCells.RemoveAndCopyValue(_interactable, cell))
+	{
+		if (TArray<TWeakObjectPtr<UInteractableComponent>>* cellInteractables = Grid.Find(cell))
+		{
+			cellInteractables->RemoveSwap(_interactable);
+			if (cellInteractables->Num() == 0)
+				Grid.Remove(cell);
+		}
+	}
+
+	InRangeInteractables.Remove(_interactable);
+}
+
+void UInteractionSubsystem::QueryInteractables(APlayerCharacter* _playerCharacter)
+{
+	const FVector playerLocation = _playerCharacter->GetActorLocation();
+	const FVector playerForward = _playerCharacter->GetActorForwardVector();
+	float capsuleRadius, capsuleHalfHeight;
+	_playerCharacter->GetCapsuleComponent()->GetScaledCapsuleSize(capsuleRadius, capsuleHalfHeight);
+
+	// Gather the candidates from the cells around the player
+	TArray<UInteractableComponent*, TInlineAllocator<16>> candidates;
+	const float searchRadius = MaxStaticReach + capsuleRadius;
+	const FIntPoint minCell = GetCellFromLocation(playerLocation - FVector(searchRadius));
+	const FIntPoint maxCell = GetCellFromLocation(playerLocation + FVector(searchRadius));
+	for (int32 y = minCell.Y; y <= maxCell.Y; ++y)
+	{
+		for (int32 x = minCell.X; x <= maxCell.X; ++x)
+		{
+			if (const TArray<TWeakObjectPtr<UInteractableComponent>>* cellInteractables = Grid.Find(FIntPoint(x, y)))
+			{
+				for (const TWeakObjectPtr<UInteractableComponent>& interactable : *cellInteractables)
+				{
+					if (interactable.IsValid())
+						candidates.Add(interactable.Get());
+				}
+			}
+		}
+	}
+	for (const TWeakObjectPtr<UInteractableComponent>& interactable : MovableInteractables)
+	{
+		if (interactable.IsValid())
+			candidates.Add(interactable.Get());
+	}
+
+	// Find which are in range and pick the best scoring one
+	TSet<TWeakObjectPtr<UInteractableComponent>> newInRange;
+	UInteractableComponent* bestInteractable = nullptr;
+	float bestScore = -BIG_NUMBER;
+	for (UInteractableComponent* interactable : candidates)
+	{
+		if (!interactable->IsPlayerInRange(playerLocation, capsuleRadius, capsuleHalfHeight))
+			continue;
+
+		newInRange.Add(interactable);
+		if (!interactable->bCanInteract)
+			continue;
+
+		const FVector toInteractable = interactable->GetOwner()->GetActorLocation() - playerLocation;
+		const float distance = toInteractable.Size2D();
+		const float facing = FVector::DotProduct(playerForward, toInteractable.GetSafeNormal2D());
+		const float score = (facing * FacingWeight) - (distance / FMath::Max(searchRadius, 1.0f));
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestInteractable = interactable;
+		}
+	}
+
+	// Exits first so the target gets cleared before a new one is set
+	for (const TWeakObjectPtr<UInteractableComponent>& interactable : InRangeInteractables)
+	{
+		if (interactable.IsValid() && !newInRange.Contains(interactable))
+			interactable->OnPlayerExitRange(_playerCharacter);
+	}
+	for (const TWeakObjectPtr<UInteractableComponent>& interactable : newInRange)
+	{
+		if (!InRangeInteractables.Contains(interactable))
+			interactable->OnPlayerEnterRange(_playerCharacter);
+	}
+	InRangeInteractables = MoveTemp(newInRange);
+
+	// Do not switch the target in the middle of a hold interaction
+	UInteractableComponent* currentTarget = _playerCharacter->GetInteractingTargetComponent();
+	if (bestInteractable &&
+		bestInteractable != currentTarget &&
+		!_playerCharacter->IsInteracting())
+	{
+		if (IsValid(currentTarget))
+			currentTarget->SetInteractionUiVisible(false);
+
+		_playerCharacter->ResetInteractionAction();
+		_playerCharacter->SetInteractionTarget(bestInteractable);
+		bestInteractable->SetInteractionUiVisible(true);
+	}
+	else if (IsValid(currentTarget) &&
+		currentTarget->IsShowingUi() &&
+		!currentTarget->bCanInteract)
+	{
+		// The target has been disabled since it was chosen
+		currentTarget->SetInteractionUiVisible(false);
+	}
+}
+
+FIntPoint UInteractionSubsystem::GetCellFromLocation(const FVector& _location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(_location.X / GridCellSize),
+		FMath::FloorToInt(_location.Y / GridCellSize));
+}
+
+UInteractionSubsystem* UInteractionSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UInteractionSubsystem>();
+	}
+	return nullptr;
+}
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "InteractionSubsystem.generated.h"
+
+/**
+ * This system finds the interactables around the player with a spatial grid
+ * It replaces the overlap events of the interaction trigger volumes, those volumes only define the range now
+ * The query runs at a fixed rate and picks the best interactable as the player's interaction target
+ */
+UCLASS()
+class CATASTROPHE_API UInteractionSubsystem : public UCatastropheGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UInteractionSubsystem();
+
+protected:
+
+	/** Time between each interaction query */
+	float QueryInterval = 0.1f;
+
+	/** The size of each cell of the grid */
+	float GridCellSize = 1000.0f;
+
+	/** How much facing the interactable matters compare to the distance when picking the target */
+	float FacingWeight = 1.0f;
+
+	/** The interactables that does not move, bucketed by the grid cell of their owner */
+	TMap<FIntPoint, TArray<TWeakObjectPtr<class UInteractableComponent>>> Grid;
+
+	/** The grid cell each static interactable is in */
+	TMap<TWeakObjectPtr<class UInteractableComponent>, FIntPoint> RegisteredCells;
+
+	/** The interactables that can move, they are tested on every query */
+	TArray<TWeakObjectPtr<class UInteractableComponent>> MovableInteractables;
+
+	/** The furthest any static interactable range reaches from its owner */
+	float MaxStaticReach = 0.0f;
+
+	/** The interactables the player is currently in range of */
+	TSet<TWeakObjectPtr<class UInteractableComponent>> InRangeInteractables;
+
+	/** Time left until the next query */
+	float QueryTimer = 0.0f;
+
+	bool bInitialized = false;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObject interface */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	/** FTickableGameObject interface End */
+
+	/**
+	 * Adds the interactable to the query
+	 * @author Richard Wulansari
+	 * @param _interactable The interactable with its range volumes registered
+	 */
+	void RegisterInteractable(class UInteractableComponent* _interactable);
+
+	/**
+	 * Removes the interactable from the query
+	 * @author Richard Wulansari
+	 * @param _interactable The interactable to remove
+	 */
+	void UnregisterInteractable(class UInteractableComponent* _interactable);
+
+	/** Gets the instance without going through the GameInstance */
+	static UInteractionSubsystem* GetInst(const UObject* _worldContextObject);
+
+private:
+
+	/** Runs the range query around the player and updates the interaction target */
+	void QueryInteractables(class APlayerCharacter* _playerCharacter);
+
+	/** Gets the grid cell of a world location */
+	FIntPoint GetCellFromLocation(const FVector& _location) const;
+
+};
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NoisePropagationSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+
+#include "NoisePropagationVolume.h"
+
+UNoisePropagationSubsystem::UNoisePropagationSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UNoisePropagationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+}
+
+void UNoisePropagationSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	Volumes.Empty();
+}
+
+void UNoisePropagationSubsystem::RegisterVolume(ANoisePropagationVolume* _volume)
+{
+	if (IsValid(_volume))
+		Volumes.AddUnique(_volume);
+}
+
+void UNoisePropagationSubsystem::UnregisterVolume(ANoisePropagationVolume* _volume)
+{
+	Volumes.Remove(_volume);
+}
+
+bool UNoisePropagationSubsystem::CanNoiseReach(const FVector& _noiseLocation, const FVector& _listenerLocation, float _loudnessRadius, bool& _bOutHasField) const
+{
+	_bOutHasField = false;
+
+	for (ANoisePropagationVolume* volume : Volumes)
+	{
+		if (!IsValid(volume) || !volume->ContainsLocation(_noiseLocation))
+			continue;
+
+		// Both ends has to be inside the same field
+		if (!volume->ContainsLocation(_listenerLocation))
+			continue;
+
+		_bOutHasField = true;
+		float pathDistance = 0.0f;
+		return volume->GetBakedDistance(_noiseLocation, _listenerLocation, pathDistance)
+			&& pathDistance <= _loudnessRadius;
+	}
+
+	return false;
+}
+
+UNoisePropagationSubsystem* UNoisePropagationSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UNoisePropagationSubsystem>();
+	}
+	return nullptr;
+}
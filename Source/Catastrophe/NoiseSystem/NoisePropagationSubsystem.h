@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "NoisePropagationSubsystem.generated.h"
+
+/**
+ * This system answers if a noise can reach a listener using the baked noise fields
+ * of the currently loaded streaming levels
+ */
+UCLASS()
+class CATASTROPHE_API UNoisePropagationSubsystem : public UCatastropheGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UNoisePropagationSubsystem();
+
+protected:
+
+	/** All the noise fields of the currently loaded levels */
+	UPROPERTY()
+	TArray<class ANoisePropagationVolume*> Volumes;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/** Called by the noise field when its level is loaded */
+	void RegisterVolume(class ANoisePropagationVolume* _volume);
+
+	/** Called by the noise field when its level is unloaded */
+	void UnregisterVolume(class ANoisePropagationVolume* _volume);
+
+	/**
+	 * Check if a noise at a location reaches the listener
+	 * @author Richard Wulansari
+	 * @param _noiseLocation Where the noise is made
+	 * @param _listenerLocation Where the listener is
+	 * @param _loudnessRadius The maximum nav path distance the noise can travel
+	 * @param _bOutHasField False if no baked field covers both locations, the result should not be trusted then
+	 * @return True if the noise can be heard
+	 */
+	UFUNCTION(BlueprintCallable, Category = "NoiseSystem")
+	bool CanNoiseReach(const FVector& _noiseLocation, const FVector& _listenerLocation, float _loudnessRadius, bool& _bOutHasField) const;
+
+	/** Gets the instance without going through the GameInstance */
+	static UNoisePropagationSubsystem* GetInst(const UObject* _worldContextObject);
+
+};
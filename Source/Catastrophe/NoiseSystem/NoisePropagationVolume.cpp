@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "NoisePropagationVolume.h"
+
+#include "Components/BoxComponent.h"
+#include "NavigationSystem.h"
+
+#include "Catastrophe.h"
+#include "NoisePropagationSubsystem.h"
+
+// Sets default values
+ANoisePropagationVolume::ANoisePropagationVolume()
+{
+	// Pure data actor, no tick needed
+	PrimaryActorTick.bCanEverTick = false;
+
+	FieldBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("FieldBounds"));
+	FieldBounds->SetBoxExtent(FVector(2000.0f, 2000.0f, 500.0f));
+	FieldBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	FieldBounds->SetGenerateOverlapEvents(false);
+	FieldBounds->SetCanEverAffectNavigation(false);
+	RootComponent = FieldBounds;
+}
+
+// Called when the game starts or when spawned
+void ANoisePropagationVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!HasBakedData())
+	{
+		UE_LOG(LogNoiseSystem, Warning, TEXT("%s has no baked noise field"), *GetName());
+		return;
+	}
+
+	if (UNoisePropagationSubsystem* noiseSystem = UNoisePropagationSubsystem::GetInst(this))
+		noiseSystem->RegisterVolume(this);
+}
+
+void ANoisePropagationVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (UNoisePropagationSubsystem* noiseSystem = UNoisePropagationSubsystem::GetInst(this))
+		noiseSystem->UnregisterVolume(this);
+}
+
+void ANoisePropagationVolume::BakeNoiseField()
+{
+	UNavigationSystemV1* navSystem = UNavigationSystemV1::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!navSystem || CellSize <= 0.0f || DistanceQuantization <= 0.0f)
+	{
+		UE_LOG(LogNoiseSystem, Error, TEXT("%s: Cannot bake noise field, missing nav system or invalid cell size"), *GetName());
+		return;
+	}
+
+	Modify();
+
+	// Lay out the coarse grid over the bounds, in the space of the volume
+	const FTransform gridTransform = GetGridTransform();
+	const FVector boundsSize = FieldBounds->GetScaledBoxExtent() * 2.0f;
+	GridLocalOrigin = -FieldBounds->GetScaledBoxExtent();
+	CellCount = FIntVector(
+		FMath::Max(1, FMath::CeilToInt(boundsSize.X / CellSize)),
+		FMath::Max(1, FMath::CeilToInt(boundsSize.Y / CellSize)),
+		FMath::Max(1, FMath::CeilToInt(boundsSize.Z / CellSize)));
+
+	// Project every cell center onto the nav mesh, cells without nav are skipped
+	TArray<FVector> navCellLocations;
+	CellToNavIndex.Init(INDEX_NONE, CellCount.X * CellCount.Y * CellCount.Z);
+	for (int32 z = 0; z < CellCount.Z; ++z)
+	{
+		for (int32 y = 0; y < CellCount.Y; ++y)
+		{
+			for (int32 x = 0; x < CellCount.X; ++x)
+			{
+				const FVector cellCenter = gridTransform.TransformPositionNoScale(
+					GridLocalOrigin + (FVector(x, y, z) + 0.5f) * CellSize);
+				FNavLocation navLocation;
+				if (navSystem->ProjectPointToNavigation(cellCenter, navLocation, NavProjectionExtent))
+				{
+					const int32 cellIndex = x + (y * CellCount.X) + (z * CellCount.X * CellCount.Y);
+					CellToNavIndex[cellIndex] = navCellLocations.Add(navLocation.Location);
+				}
+			}
+		}
+	}
+
+	// Path distance between every pair of cells, the table is symmetric
+	NavCellCount = navCellLocations.Num();
+	DistanceTable.Init(UnreachableDistance, NavCellCount * NavCellCount);
+	for (int32 a = 0; a < NavCellCount; ++a)
+	{
+		DistanceTable[a * NavCellCount + a] = 0;
+		for (int32 b = a + 1; b < NavCellCount; ++b)
+		{
+			float pathLength = 0.0f;
+			const ENavigationQueryResult::Type result =
+				navSystem->GetPathLength(navCellLocations[a], navCellLocations[b], pathLength);
+			if (result != ENavigationQueryResult::Success)
+				continue;
+
+			const uint16 quantizedDistance = (uint16)FMath::Min(
+				FMath::CeilToInt(pathLength / DistanceQuantization), (int32)UnreachableDistance - 1);
+			DistanceTable[a * NavCellCount + b] = quantizedDistance;
+			DistanceTable[b * NavCellCount + a] = quantizedDistance;
+		}
+	}
+
+	UE_LOG(LogNoiseSystem, Log, TEXT("%s: Baked noise field with %d nav cells"), *GetName(), NavCellCount);
+}
+
+bool ANoisePropagationVolume::ContainsLocation(const FVector& _location) const
+{
+	return GetNavIndexAtLocation(_location) != INDEX_NONE;
+}
+
+bool ANoisePropagationVolume::GetBakedDistance(const FVector& _from, const FVector& _to, float& _outDistance) const
+{
+	const int32 fromIndex = GetNavIndexAtLocation(_from);
+	const int32 toIndex = GetNavIndexAtLocation(_to);
+	if (fromIndex == INDEX_NONE || toIndex == INDEX_NONE)
+		return false;
+
+	const uint16 quantizedDistance = DistanceTable[fromIndex * NavCellCount + toIndex];
+	if (quantizedDistance == UnreachableDistance)
+		return false;
+
+	_outDistance = (float)quantizedDistance * DistanceQuantization;
+	return true;
+}
+
+FTransform ANoisePropagationVolume::GetGridTransform() const
+{
+	return FTransform(GetActorQuat(), GetActorLocation());
+}
+
+int32 ANoisePropagationVolume::GetNavIndexAtLocation(const FVector& _location) const
+{
+	if (!HasBakedData())
+		return INDEX_NONE;
+
+	const FVector local = (GetGridTransform().InverseTransformPositionNoScale(_location) - GridLocalOrigin) / CellSize;
+	const int32 x = FMath::FloorToInt(local.X);
+	const int32 y = FMath::FloorToInt(local.Y);
+	const int32 z = FMath::FloorToInt(local.Z);
+	if (x < 0 || y < 0 || z < 0 ||
+		x >= CellCount.X || y >= CellCount.Y || z >= CellCount.Z)
+	{
+		return INDEX_NONE;
+	}
+
+	return CellToNavIndex[x + (y * CellCount.X) + (z * CellCount.X * CellCount.Y)];
+}
@@ -0,0 +1,113 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "NoisePropagationVolume.generated.h"
+
+/**
+ * This actor holds a baked nav distance field for noise propagation inside its bounds
+ * Place one per streaming level, then press "BakeNoiseField" in the editor after the nav mesh is built
+ * The grid is aligned to the volume, the scale of the volume only affects the bounds
+ * At runtime a noise reaching a listener is a table lookup, no traces or overlaps
+ */
+UCLASS()
+class CATASTROPHE_API ANoisePropagationVolume : public AActor
+{
+	GENERATED_BODY()
+
+private:
+
+	/** The bounds of the noise field */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
+	class UBoxComponent* FieldBounds;
+
+public:
+	// Sets default values for this actor's properties
+	ANoisePropagationVolume();
+
+protected:
+
+	/** The size of each cell of the coarse emitter grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NoiseSystem")
+	float CellSize = 400.0f;
+
+	/** The distance one unit in the baked table represents */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NoiseSystem")
+	float DistanceQuantization = 10.0f;
+
+	/** Search extent used when projecting the cell centers onto the nav mesh during bake */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NoiseSystem")
+	FVector NavProjectionExtent = FVector(200.0f, 200.0f, 200.0f);
+
+	/** Number of cells on each axis, filled in by the bake */
+	UPROPERTY(VisibleAnywhere, Category = "NoiseSystem")
+	FIntVector CellCount;
+
+	/** The minimum corner of the grid relative to the volume, so the field moves with the volume and its level */
+	UPROPERTY(VisibleAnywhere, Category = "NoiseSystem")
+	FVector GridLocalOrigin;
+
+	/** Maps each grid cell to its row in the distance table, INDEX_NONE if the cell has no nav mesh */
+	UPROPERTY()
+	TArray<int32> CellToNavIndex;
+
+	/** Baked path distance between each pair of nav cells, in DistanceQuantization units */
+	UPROPERTY()
+	TArray<uint16> DistanceTable;
+
+	/** Number of cells that has nav mesh, the distance table is this number squared */
+	UPROPERTY(VisibleAnywhere, Category = "NoiseSystem")
+	int32 NavCellCount = 0;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/** Called when the actor has destroyed */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+
+	/** Value stored in the table when two cells are not connected */
+	static const uint16 UnreachableDistance = MAX_uint16;
+
+	/**
+	 * Bakes the nav distance field of all the cells inside the bounds
+	 * @author Richard Wulansari
+	 * @note Editor only, requires the nav mesh to be built
+	 */
+	UFUNCTION(CallInEditor, Category = "NoiseSystem")
+	void BakeNoiseField();
+
+	/**
+	 * Check if the field contains baked data for the location
+	 * @author Richard Wulansari
+	 * @param _location World space location
+	 */
+	bool ContainsLocation(const FVector& _location) const;
+
+	/**
+	 * Gets the baked path distance between two locations
+	 * @author Richard Wulansari
+	 * @param _from World location of the noise
+	 * @param _to World location of the listener
+	 * @param _outDistance The nav path distance
+	 * @return False if either location has no baked data, or they are not connected
+	 */
+	bool GetBakedDistance(const FVector& _from, const FVector& _to, float& _outDistance) const;
+
+	/** Getter */
+	FORCEINLINE bool HasBakedData() const { return NavCellCount > 0; }
+	/** Getter End */
+
+private:
+
+	/** Gets the transform of the grid, the volume without its scale */
+	FTransform GetGridTransform() const;
+
+	/** Gets the row in the distance table of the location, INDEX_NONE if none */
+	int32 GetNavIndexAtLocation(const FVector& _location) const;
+
+};
@@ -2,9 +2,13 @@
 
 #include "Quest.h"
 
+#include "Kismet/GameplayStatics.h"
+
 #include "Catastrophe.h"
 #include "QuestSubsystem.h"
 #include "QuestObjectiveComponent.h"
+#include "Characters/PlayerCharacter/PlayerCharacter.h"
+#include "Characters/PlayerCharacter/PlayerHudModel.h"
 
 #include "DebugUtility/CatastropheDebug.h"
 
@@ -40,6 +44,12 @@ void UQuest::ActivateQuest()
 	if (QuestObjectives.Num() > 0)
 	{
 		QuestObjectives[0]->ActivateObjective();
+
+		// The hud shows the first objective, the following ones are set when the previous completes
+		APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(
+			UGameplayStatics::GetPlayerCharacter(QuestObjectives[0], 0));
+		if (playerCharacter && playerCharacter->GetHudModel())
+			playerCharacter->GetHudModel()->SetQuestText(QuestObjectives[0]->GetPopupText());
 	}
 	else
 	{
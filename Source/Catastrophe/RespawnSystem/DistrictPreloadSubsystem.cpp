@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DistrictPreloadSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/Level.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Components/AudioComponent.h"
+#include "UObject/UnrealType.h"
+
+UDistrictPreloadSubsystem::UDistrictPreloadSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UDistrictPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PreloadHandles.SetNum((int32)EDISTRICT::COUNT);
+}
+
+void UDistrictPreloadSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	for (TSharedPtr<FStreamableHandle>& handle : PreloadHandles)
+	{
+		if (handle.IsValid())
+			handle->ReleaseHandle();
+	}
+	PreloadHandles.Empty();
+}
+
+void UDistrictPreloadSubsystem::RequestPreload(EDISTRICT _district, const TArray<FSoftObjectPath>& _assets)
+{
+	if (!PreloadHandles.IsValidIndex((int32)_district) || _assets.Num() <= 0) return;
+
+	TSharedPtr<FStreamableHandle>& handle = PreloadHandles[(int32)_district];
+	if (handle.IsValid() && handle->IsActive())
+	{
+		// The same bundle in any order is not requested again, a bundle of the same size with other assets is
+		TArray<FSoftObjectPath> requestedAssets;
+		handle->GetRequestedAssets(requestedAssets);
+		const TSet<FSoftObjectPath> requestedAssetSet(requestedAssets);
+		const TSet<FSoftObjectPath> assetSet(_assets);
+		if (requestedAssetSet.Num() == assetSet.Num() && requestedAssetSet.Includes(assetSet))
+			return;
+
+		handle->ReleaseHandle();
+	}
+
+	// The bundle competes with the district levels, it is needed before their actors begin play
+	handle = StreamableManager.RequestAsyncLoad(
+		_assets,
+		FStreamableDelegate(),
+		FStreamableManager::AsyncLoadHighPriority,
+		false,
+		false,
+		TEXT("DistrictPreload"));
+}
+
+void UDistrictPreloadSubsystem::ReleasePreload(EDISTRICT _district)
+{
+	if (!PreloadHandles.IsValidIndex((int32)_district)) return;
+
+	TSharedPtr<FStreamableHandle>& handle = PreloadHandles[(int32)_district];
+	if (handle.IsValid())
+		handle->ReleaseHandle();
+	handle.Reset();
+}
+
+bool UDistrictPreloadSubsystem::IsPreloadComplete(EDISTRICT _district) const
+{
+	if (!PreloadHandles.IsValidIndex((int32)_district)) return false;
+
+	const TSharedPtr<FStreamableHandle>& handle = PreloadHandles[(int32)_district];
+	return handle.IsValid() && handle->HasLoadCompleted();
+}
+
+void UDistrictPreloadSubsystem::CollectLevelPreloadAssets(ULevel* _level, TArray<FSoftObjectPath>& _outAssets)
+{
+	if (!_level) return;
+
+	for (AActor* actor : _level->Actors)
+	{
+		if (!actor)
+			continue;
+
+		if (Cast<UBlueprintGeneratedClass>(actor->GetClass()))
+			_outAssets.AddUnique(FSoftObjectPath(actor->GetClass()));
+
+		TInlineComponentArray<UActorComponent*> components(actor);
+		for (UActorComponent* component : components)
+		{
+			if (UParticleSystemComponent* particleComponent = Cast<UParticleSystemComponent>(component))
+			{
+				if (particleComponent->Template)
+					_outAssets.AddUnique(FSoftObjectPath(particleComponent->Template));
+			}
+			else if (UAudioComponent* audioComponent = Cast<UAudioComponent>(component))
+			{
+				if (audioComponent->Sound)
+					_outAssets.AddUnique(FSoftObjectPath(audioComponent->Sound));
+			}
+		}
+
+		// Soft references are what gets loaded synchronously on first use, e.g. footstep sounds and spawned effects
+		for (TFieldIterator<USoftObjectProperty> propertyIt(actor->GetClass()); propertyIt; ++propertyIt)
+		{
+			const FSoftObjectPtr& softObject = propertyIt->GetPropertyValue_InContainer(actor);
+			if (!softObject.IsNull())
+				_outAssets.AddUnique(softObject.ToSoftObjectPath());
+		}
+	}
+}
+
+UDistrictPreloadSubsystem* UDistrictPreloadSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UDistrictPreloadSubsystem>();
+	}
+	return nullptr;
+}
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "RespawnSystemTypes.h"
+#include "DistrictPreloadSubsystem.generated.h"
+
+/**
+ * This system loads the assets of a district asynchronously before they are first used,
+ * e.g. the guard blueprints, the particle effects and the sounds, so they do not load synchronously when the actors appear
+ * The assets stay loaded while their handle is held, the respawn system holds the handles of the districts that are resident
+ */
+UCLASS()
+class CATASTROPHE_API UDistrictPreloadSubsystem : public UCatastropheGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UDistrictPreloadSubsystem();
+
+protected:
+
+	FStreamableManager StreamableManager;
+
+	/** The handles of the requested bundles, indexed by district */
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Requests the bundle of a district to load asynchronously, the handle is held until it is released
+	 * @author Richard Wulansari
+	 * @param _district
+	 * @param _assets
+	 * @note A bundle that is already held is requested again only if it has changed
+	 */
+	void RequestPreload(EDISTRICT _district, const TArray<FSoftObjectPath>& _assets);
+
+	/**
+	 * Releases the handle of a district bundle, the assets can be garbage collected once nothing else uses them
+	 * @author Richard Wulansari
+	 * @param _district
+	 */
+	void ReleasePreload(EDISTRICT _district);
+
+	/** Check if the bundle of a district has finished loading */
+	UFUNCTION(BlueprintPure, Category = "Respawn System")
+	bool IsPreloadComplete(EDISTRICT _district) const;
+
+	/**
+	 * Collects the assets a loaded level uses that are worth preloading,
+	 * the blueprint classes of its actors, their particle systems and sounds, and their soft references
+	 * @author Richard Wulansari
+	 * @param _level
+	 * @param _outAssets The assets are added unique
+	 */
+	static void CollectLevelPreloadAssets(class ULevel* _level, TArray<FSoftObjectPath>& _outAssets);
+
+	/** Gets the instance without going through the GameInstance */
+	static UDistrictPreloadSubsystem* GetInst(const UObject* _worldContextObject);
+
+};
@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelResidencySubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Texture.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/PlatformTime.h"
+
+ULevelResidencySubsystem::ULevelResidencySubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void ULevelResidencySubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	Levels.Empty();
+}
+
+void ULevelResidencySubsystem::RegisterLevel(FName _levelName, ULevelStreaming* _streamingLevel)
+{
+	FLevelResidencyInfo& info = Levels.FindOrAdd(_levelName);
+	info.StreamingLevel = _streamingLevel;
+
+	if (info.EstimatedSizeMB < 0.0f && _streamingLevel && _streamingLevel->GetLoadedLevel())
+		info.EstimatedSizeMB = EstimateLevelSizeMB(_streamingLevel->GetLoadedLevel());
+}
+
+void ULevelResidencySubsystem::NotifyLevelVisible(FName _levelName, ULevelStreaming* _streamingLevel)
+{
+	FLevelResidencyInfo& info = Levels.FindOrAdd(_levelName);
+	info.StreamingLevel = _streamingLevel;
+	info.LastUsedTime = FPlatformTime::Seconds();
+
+	// The content of a level does not change, it only has to be measured once
+	if (info.EstimatedSizeMB < 0.0f && _streamingLevel && _streamingLevel->GetLoadedLevel())
+		info.EstimatedSizeMB = EstimateLevelSizeMB(_streamingLevel->GetLoadedLevel());
+}
+
+void ULevelResidencySubsystem::TouchLevels(const TArray<FName>& _levelNames)
+{
+	const double currentTime = FPlatformTime::Seconds();
+	for (FName levelName : _levelNames)
+	{
+		Levels.FindOrAdd(levelName).LastUsedTime = currentTime;
+	}
+}
+
+void ULevelResidencySubsystem::SelectLevelsToEvict(const TArray<FName>& _requiredLevels, const TArray<FName>& _candidates, TArray<FName>& _outEvictions) const
+{
+	float totalSize = GetResidentSizeMB();
+	for (FName levelName : _requiredLevels)
+	{
+		const FLevelResidencyInfo* info = Levels.Find(levelName);
+		if (!info || !IsLevelResident(*info))
+			totalSize += GetEstimatedLevelSizeMB(levelName);
+	}
+
+	if (totalSize <= ResidencyBudgetMB)
+		return;
+
+	// Least recently used first
+	TArray<FName> sortedCandidates = _candidates;
+	sortedCandidates.Sort([this](const FName& _a, const FName& _b)
+	{
+		const FLevelResidencyInfo* infoA = Levels.Find(_a);
+		const FLevelResidencyInfo* infoB = Levels.Find(_b);
+		return (infoA ? infoA->LastUsedTime : 0.0) < (infoB ? infoB->LastUsedTime : 0.0);
+	});
+
+	for (FName levelName : sortedCandidates)
+	{
+		if (totalSize <= ResidencyBudgetMB)
+			break;
+
+		_outEvictions.Add(levelName);
+		totalSize -= GetEstimatedLevelSizeMB(levelName);
+	}
+}
+
+bool ULevelResidencySubsystem::HasRoomFor(const TArray<FName>& _levelNames) const
+{
+	float totalSize = GetResidentSizeMB();
+	for (FName levelName : _levelNames)
+	{
+		const FLevelResidencyInfo* info = Levels.Find(levelName);
+		if (!info || !IsLevelResident(*info))
+			totalSize += GetEstimatedLevelSizeMB(levelName);
+	}
+	return totalSize <= ResidencyBudgetMB;
+}
+
+float ULevelResidencySubsystem::GetResidentSizeMB() const
+{
+	float totalSize = 0.0f;
+	for (const TPair<FName, FLevelResidencyInfo>& level : Levels)
+	{
+		if (IsLevelResident(level.Value))
+			totalSize += level.Value.EstimatedSizeMB >= 0.0f ? level.Value.EstimatedSizeMB : DefaultLevelSizeMB;
+	}
+	return totalSize;
+}
+
+float ULevelResidencySubsystem::GetEstimatedLevelSizeMB(FName _levelName) const
+{
+	const FLevelResidencyInfo* info = Levels.Find(_levelName);
+	return info && info->EstimatedSizeMB >= 0.0f ? info->EstimatedSizeMB : DefaultLevelSizeMB;
+}
+
+ULevelResidencySubsystem* ULevelResidencySubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<ULevelResidencySubsystem>();
+	}
+	return nullptr;
+}
+
+bool ULevelResidencySubsystem::IsLevelResident(const FLevelResidencyInfo& _info)
+{
+	ULevelStreaming* streamLevel = _info.StreamingLevel.Get();
+	return streamLevel && (streamLevel->IsLevelLoaded() || streamLevel->ShouldBeLoaded());
+}
+
+float ULevelResidencySubsystem::EstimateLevelSizeMB(ULevel* _level)
+{
+	SIZE_T totalBytes = 0;
+	TSet<UObject*> countedAssets;
+
+	auto countAsset = [&totalBytes, &countedAssets](UObject* _asset)
+	{
+		if (!_asset || countedAssets.Contains(_asset))
+			return;
+
+		countedAssets.Add(_asset);
+		totalBytes += _asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	};
+
+	for (AActor* actor : _level->Actors)
+	{
+		if (!actor)
+			continue;
+
+		totalBytes += actor->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		TInlineComponentArray<UPrimitiveComponent*> primitiveComponents(actor);
+		for (UPrimitiveComponent* primitiveComponent : primitiveComponents)
+		{
+			totalBytes += primitiveComponent->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+			if (UStaticMeshComponent* staticMeshComponent = Cast<UStaticMeshComponent>(primitiveComponent))
+				countAsset(staticMeshComponent->GetStaticMesh());
+			else if (USkeletalMeshComponent* skeletalMeshComponent = Cast<USkeletalMeshComponent>(primitiveComponent))
+				countAsset(skeletalMeshComponent->SkeletalMesh);
+
+			TArray<UTexture*> usedTextures;
+			primitiveComponent->GetUsedTextures(usedTextures, EMaterialQualityLevel::Num);
+			for (UTexture* texture : usedTextures)
+			{
+				countAsset(texture);
+			}
+		}
+	}
+
+	return totalBytes / (1024.0f * 1024.0f);
+}
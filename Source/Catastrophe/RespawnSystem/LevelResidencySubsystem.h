@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "LevelResidencySubsystem.generated.h"
+
+/** What the residency manager knows about a streaming level */
+struct FLevelResidencyInfo
+{
+	TWeakObjectPtr<class ULevelStreaming> StreamingLevel;
+
+	/** The estimated memory of the level in MB, negative until the level has been measured */
+	float EstimatedSizeMB = -1.0f;
+
+	/** The last time a district that needs this level has been entered */
+	double LastUsedTime = 0.0;
+};
+
+/**
+ * This system decides which streaming levels stay loaded when they are not needed
+ * Levels that are not needed are kept loaded but hidden until the estimated size of all loaded levels exceeds the budget,
+ * then the least recently used ones are unloaded
+ * A resident level is restored from its snapshot when its district is entered again, it does not keep the state it was left in
+ */
+UCLASS()
+class CATASTROPHE_API ULevelResidencySubsystem : public UCatastropheGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULevelResidencySubsystem();
+
+	/** The estimated memory all the loaded streaming levels may take in MB */
+	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
+	float ResidencyBudgetMB = 1536.0f;
+
+	/** The size assumed for a level that has not been measured yet in MB */
+	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
+	float DefaultLevelSizeMB = 150.0f;
+
+protected:
+
+	/** The known levels by name */
+	TMap<FName, FLevelResidencyInfo> Levels;
+
+public:
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Adds a level to the ones counted by the budget, it is measured if it is already loaded
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 * @param _streamingLevel
+	 * @note Does not mark the level as used
+	 */
+	void RegisterLevel(FName _levelName, class ULevelStreaming* _streamingLevel);
+
+	/**
+	 * Called when a level has become visible, it is measured the first time and marked as used
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 * @param _streamingLevel
+	 */
+	void NotifyLevelVisible(FName _levelName, class ULevelStreaming* _streamingLevel);
+
+	/**
+	 * Marks levels as used now, e.g. the levels of the district being entered
+	 * @author Richard Wulansari
+	 * @param _levelNames
+	 */
+	void TouchLevels(const TArray<FName>& _levelNames);
+
+	/**
+	 * Chooses the levels to unload so that the loaded levels and the required levels fit in the budget
+	 * @author Richard Wulansari
+	 * @param _requiredLevels The levels that will be loaded, they are counted even if they are not loaded yet
+	 * @param _candidates The loaded levels that are not needed, the least recently used ones are chosen first
+	 * @param _outEvictions The chosen levels, the rest of the candidates can stay loaded but hidden
+	 */
+	void SelectLevelsToEvict(const TArray<FName>& _requiredLevels, const TArray<FName>& _candidates, TArray<FName>& _outEvictions) const;
+
+	/**
+	 * Check if levels can be loaded in addition to the loaded ones without exceeding the budget
+	 * @author Richard Wulansari
+	 * @param _levelNames
+	 */
+	bool HasRoomFor(const TArray<FName>& _levelNames) const;
+
+	/** Gets the estimated memory of all the loaded levels in MB */
+	UFUNCTION(BlueprintPure, Category = "Respawn System")
+	float GetResidentSizeMB() const;
+
+	/** Gets the estimated memory of a level in MB, the default size if it has not been measured */
+	UFUNCTION(BlueprintPure, Category = "Respawn System")
+	float GetEstimatedLevelSizeMB(FName _levelName) const;
+
+	/** Gets the instance without going through the GameInstance */
+	static ULevelResidencySubsystem* GetInst(const UObject* _worldContextObject);
+
+private:
+
+	/** Check if a level is loaded or has been requested to load */
+	static bool IsLevelResident(const FLevelResidencyInfo& _info);
+
+	/**
+	 * Estimates the memory of a level from its actors and the meshes and textures they use
+	 * @author Richard Wulansari
+	 * @param _level
+	 * @note Assets shared with other levels are counted for each of them, the estimate errs on the large side
+	 */
+	static float EstimateLevelSizeMB(class ULevel* _level);
+
+};
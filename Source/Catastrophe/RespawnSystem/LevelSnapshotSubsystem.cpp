@@ -0,0 +1,397 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "LevelSnapshotSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+#include "Serialization/ArchiveProxy.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "DestructibleComponent.h"
+
+#include "ResettableActorInterface.h"
+#include "Characters/GuardCharacter/Guard.h"
+#include "Interactable/ItemPickup.h"
+#include "Interactable/ItemCrate.h"
+#include "Interactable/DoorTrigger.h"
+#include "Gameplay/Items/CollectableItem.h"
+
+#include "DebugUtility/CatastropheDebug.h"
+
+/**
+ * Serializes the properties of an actor and its components so they can be restored into the same or a pooled actor
+ * References to subobjects of the actor are stored relative to it, references to other world objects by path
+ */
+class FActorSnapshotArchive : public FArchiveProxy
+{
+private:
+
+	enum class EReferenceType : uint8
+	{
+		Null,
+		Actor,
+		Subobject,
+		Path
+	};
+
+	AActor* Actor;
+
+public:
+
+	FActorSnapshotArchive(FArchive& _innerArchive, AActor* _actor)
+		: FArchiveProxy(_innerArchive)
+		, Actor(_actor)
+	{
+		// Skip transient properties and write every property, not only the ones different to the defaults
+		ArIsPersistent = true;
+		ArNoDelta = true;
+	}
+
+	virtual FArchive& operator<<(UObject*& _object) override
+	{
+		uint8 referenceType = (uint8)EReferenceType::Null;
+		FString path;
+
+		if (IsLoading())
+		{
+			*this << referenceType;
+			*this << path;
+
+			// An object that cannot be found, e.g. a runtime subobject of a destroyed actor, keeps the current value
+			switch ((EReferenceType)referenceType)
+			{
+			case EReferenceType::Null:
+				_object = nullptr;
+				break;
+			case EReferenceType::Actor:
+				_object = Actor;
+				break;
+			case EReferenceType::Subobject:
+				if (UObject* subobject = StaticFindObject(UObject::StaticClass(), Actor, *path))
+					_object = subobject;
+				break;
+			case EReferenceType::Path:
+				if (UObject* object = StaticFindObject(UObject::StaticClass(), nullptr, *path))
+					_object = object;
+				break;
+			}
+		}
+		else
+		{
+			if (!_object)
+			{
+				referenceType = (uint8)EReferenceType::Null;
+			}
+			else if (_object == Actor)
+			{
+				referenceType = (uint8)EReferenceType::Actor;
+			}
+			else if (_object->IsIn(Actor))
+			{
+				referenceType = (uint8)EReferenceType::Subobject;
+				path = _object->GetPathName(Actor);
+			}
+			else
+			{
+				referenceType = (uint8)EReferenceType::Path;
+				path = _object->GetPathName();
+			}
+
+			*this << referenceType;
+			*this << path;
+		}
+		return *this;
+	}
+
+	virtual bool ShouldSkipProperty(const UProperty* _property) const override
+	{
+		// The relations to other actors belong to them, a pooled actor must not take them over
+		const UObjectPropertyBase* objectProperty = Cast<UObjectPropertyBase>(_property);
+		if (objectProperty && objectProperty->PropertyClass->IsChildOf(AController::StaticClass()))
+			return true;
+
+		// The bindings are made at runtime, e.g. OnDestroyed of this system, they must survive the restore
+		if (_property->IsA<UMulticastDelegateProperty>() || _property->IsA<UDelegateProperty>())
+			return true;
+
+		static const FName ownerName = TEXT("Owner");
+		static const FName instigatorName = TEXT("Instigator");
+		static const FName attachParentName = TEXT("AttachParent");
+		static const FName attachChildrenName = TEXT("AttachChildren");
+
+		const FName propertyName = _property->GetFName();
+		return propertyName == ownerName ||
+			propertyName == instigatorName ||
+			propertyName == attachParentName ||
+			propertyName == attachChildrenName;
+	}
+
+	virtual FString GetArchiveName() const override { return TEXT("FActorSnapshotArchive"); }
+};
+
+ULevelSnapshotSubsystem::ULevelSnapshotSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void ULevelSnapshotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+		this, &ULevelSnapshotSubsystem::OnLevelAddedToWorld);
+	LevelRemovedFromWorldHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(
+		this, &ULevelSnapshotSubsystem::OnLevelRemovedFromWorld);
+}
+
+void ULevelSnapshotSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedFromWorldHandle);
+	LevelSnapshots.Empty();
+}
+
+void ULevelSnapshotSubsystem::RegisterResettableLevel(FName _levelName, bool _bSnapshotIfVisible)
+{
+	ResettableLevelNames.Add(_levelName);
+	if (!_bSnapshotIfVisible) return;
+
+	ULevelStreaming* streamLevel = UGameplayStatics::GetStreamingLevel(this, _levelName);
+	if (streamLevel && streamLevel->IsLevelVisible() && !LevelSnapshots.Contains(_levelName))
+	{
+		TakeSnapshot(_levelName, streamLevel->GetLoadedLevel());
+	}
+}
+
+bool ULevelSnapshotSubsystem::RestoreLevel(FName _levelName)
+{
+	FLevelSnapshot* levelSnapshot = LevelSnapshots.Find(_levelName);
+	if (!levelSnapshot || !levelSnapshot->Level.IsValid())
+		return false;
+
+	TSet<AActor*> snapshotActors;
+	for (FActorSnapshot& actorSnapshot : levelSnapshot->Actors)
+	{
+		AActor* actor = actorSnapshot.Actor.Get();
+
+		// The actor has been destroyed, spawn its replacement from the pool
+		if (!actor || actor->IsPendingKillPending())
+		{
+			actor = actorSnapshot.PooledActor.Get();
+			if (!actor)
+				continue;
+
+			actor->FinishSpawning(actorSnapshot.Transform);
+			if (APawn* pawn = Cast<APawn>(actor))
+			{
+				if (!pawn->GetController())
+					pawn->SpawnDefaultController();
+			}
+
+			actor->OnDestroyed.AddDynamic(this, &ULevelSnapshotSubsystem::OnResettableActorDestroyed);
+			actorSnapshot.Actor = actor;
+			actorSnapshot.PooledActor.Reset();
+		}
+
+		DeserializeActor(actor, actorSnapshot);
+		snapshotActors.Add(actor);
+	}
+
+	// Anything resettable that was not there at the start does not belong to the level
+	ULevel* level = levelSnapshot->Level.Get();
+	for (int32 i = level->Actors.Num() - 1; i >= 0; --i)
+	{
+		AActor* actor = level->Actors[i];
+		if (!actor || actor->IsPendingKillPending() || !actor->HasActorBegunPlay())
+			continue;
+
+		if (!snapshotActors.Contains(actor) && IsResettableActor(actor))
+			actor->Destroy();
+	}
+
+	// Running logic is reset after every actor has its state back
+	for (AActor* actor : snapshotActors)
+	{
+		if (actor->GetClass()->ImplementsInterface(UResettableActorInterface::StaticClass()))
+			IResettableActorInterface::Execute_OnSnapshotRestored(actor);
+	}
+	return true;
+}
+
+bool ULevelSnapshotSubsystem::HasSnapshot(FName _levelName) const
+{
+	const FLevelSnapshot* levelSnapshot = LevelSnapshots.Find(_levelName);
+	return levelSnapshot && levelSnapshot->Level.IsValid();
+}
+
+ULevelSnapshotSubsystem* ULevelSnapshotSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<ULevelSnapshotSubsystem>();
+	}
+	return nullptr;
+}
+
+void ULevelSnapshotSubsystem::OnResettableActorDestroyed(AActor* _destroyedActor)
+{
+	UWorld* world = _destroyedActor->GetWorld();
+	ULevel* level = _destroyedActor->GetLevel();
+	if (!world || world->bIsTearingDown || !level || level->bIsBeingRemoved)
+		return;
+
+	for (TPair<FName, FLevelSnapshot>& levelSnapshot : LevelSnapshots)
+	{
+		for (FActorSnapshot& actorSnapshot : levelSnapshot.Value.Actors)
+		{
+			if (actorSnapshot.Actor.Get() != _destroyedActor)
+				continue;
+
+			// The actor is still complete here, use it as the template of a replacement
+			// It is created now and only finished spawning on restore, so a reset does not create components
+			FActorSpawnParameters spawnParams;
+			spawnParams.Template = _destroyedActor;
+			spawnParams.OverrideLevel = level;
+			spawnParams.bDeferConstruction = true;
+			spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			actorSnapshot.PooledActor = world->SpawnActor<AActor>(
+				_destroyedActor->GetClass(), actorSnapshot.Transform, spawnParams);
+			return;
+		}
+	}
+}
+
+void ULevelSnapshotSubsystem::OnLevelAddedToWorld(ULevel* _level, UWorld* _world)
+{
+	if (_world != GetWorld()) return;
+
+	const FName levelName = FindResettableLevelName(_level);
+	if (levelName.IsNone())
+		return;
+
+	// A hidden level that is shown again has been played, only the first add after the package has loaded is snapshot
+	const FLevelSnapshot* levelSnapshot = LevelSnapshots.Find(levelName);
+	if (levelSnapshot && levelSnapshot->Level.Get() == _level)
+		return;
+
+	TakeSnapshot(levelName, _level);
+}
+
+void ULevelSnapshotSubsystem::OnLevelRemovedFromWorld(ULevel* _level, UWorld* _world)
+{
+	// A level that is only hidden keeps its actors, and its snapshot with them
+	const FName levelName = _level ? FindResettableLevelName(_level) : NAME_None;
+	ULevelStreaming* streamLevel = levelName.IsNone() ? nullptr : UGameplayStatics::GetStreamingLevel(this, levelName);
+	if (streamLevel && streamLevel->ShouldBeLoaded())
+		return;
+
+	// The actors are gone with the level, the next load takes a new snapshot
+	for (auto iterator = LevelSnapshots.CreateIterator(); iterator; ++iterator)
+	{
+		if (!iterator.Value().Level.IsValid() || iterator.Value().Level.Get() == _level)
+			iterator.RemoveCurrent();
+	}
+}
+
+void ULevelSnapshotSubsystem::TakeSnapshot(FName _levelName, ULevel* _level)
+{
+	if (!_level) return;
+
+	FLevelSnapshot& levelSnapshot = LevelSnapshots.Add(_levelName);
+	levelSnapshot.Level = _level;
+
+	for (AActor* actor : _level->Actors)
+	{
+		if (!actor || actor->IsPendingKillPending() || !IsResettableActor(actor))
+			continue;
+
+		FActorSnapshot& actorSnapshot = levelSnapshot.Actors.AddDefaulted_GetRef();
+		SerializeActor(actor, actorSnapshot);
+		actor->OnDestroyed.AddUniqueDynamic(this, &ULevelSnapshotSubsystem::OnResettableActorDestroyed);
+	}
+}
+
+void ULevelSnapshotSubsystem::SerializeActor(AActor* _actor, FActorSnapshot& _snapshot)
+{
+	_snapshot.Actor = _actor;
+	_snapshot.Transform = _actor->GetActorTransform();
+
+	{
+		FMemoryWriter writer(_snapshot.ActorData);
+		FActorSnapshotArchive archive(writer, _actor);
+		_actor->SerializeScriptProperties(archive);
+	}
+
+	// Only the components every instance of the class has can be found again by name
+	TInlineComponentArray<UActorComponent*> components(_actor);
+	for (UActorComponent* component : components)
+	{
+		if (component->CreationMethod != EComponentCreationMethod::Native &&
+			component->CreationMethod != EComponentCreationMethod::SimpleConstructionScript)
+		{
+			continue;
+		}
+
+		FComponentSnapshot& componentSnapshot = _snapshot.Components.AddDefaulted_GetRef();
+		componentSnapshot.ComponentName = component->GetFName();
+		FMemoryWriter writer(componentSnapshot.Data);
+		FActorSnapshotArchive archive(writer, _actor);
+		component->SerializeScriptProperties(archive);
+	}
+}
+
+void ULevelSnapshotSubsystem::DeserializeActor(AActor* _actor, const FActorSnapshot& _snapshot)
+{
+	{
+		FMemoryReader reader(_snapshot.ActorData);
+		FActorSnapshotArchive archive(reader, _actor);
+		_actor->SerializeScriptProperties(archive);
+	}
+
+	for (const FComponentSnapshot& componentSnapshot : _snapshot.Components)
+	{
+		UActorComponent* component = FindObjectFast<UActorComponent>(_actor, componentSnapshot.ComponentName);
+		if (!component)
+			continue;
+
+		FMemoryReader reader(componentSnapshot.Data);
+		FActorSnapshotArchive archive(reader, _actor);
+		component->SerializeScriptProperties(archive);
+
+		// Rebuilds the render and physics state from the restored properties, e.g. an unbroken destructible
+		if (component->IsRegistered())
+			component->ReregisterComponent();
+	}
+
+	_actor->SetActorTransform(_snapshot.Transform, false, nullptr, ETeleportType::ResetPhysics);
+}
+
+FName ULevelSnapshotSubsystem::FindResettableLevelName(ULevel* _level) const
+{
+	for (FName levelName : ResettableLevelNames)
+	{
+		ULevelStreaming* streamLevel = UGameplayStatics::GetStreamingLevel(this, levelName);
+		if (streamLevel && streamLevel->GetLoadedLevel() == _level)
+			return levelName;
+	}
+	return NAME_None;
+}
+
+bool ULevelSnapshotSubsystem::IsResettableActor(const AActor* _actor)
+{
+	return _actor->IsA<AGuard>() ||
+		_actor->IsA<AItemPickup>() ||
+		_actor->IsA<ACollectableItem>() ||
+		_actor->IsA<AItemCrate>() ||
+		_actor->IsA<ADoorTrigger>() ||
+		_actor->FindComponentByClass<UDestructibleComponent>() ||
+		_actor->GetClass()->ImplementsInterface(UResettableActorInterface::StaticClass());
+}
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "LevelSnapshotSubsystem.generated.h"
+
+/** The serialized properties of a component, found again by name on restore */
+struct FComponentSnapshot
+{
+	FName ComponentName;
+
+	TArray<uint8> Data;
+};
+
+/** The initial state of a resettable actor */
+struct FActorSnapshot
+{
+	/** The actor the state belongs to, replaced by the pooled actor after it has been destroyed */
+	TWeakObjectPtr<AActor> Actor;
+
+	/** A constructed but not yet spawned copy of the actor, created when the actor is destroyed */
+	TWeakObjectPtr<AActor> PooledActor;
+
+	FTransform Transform;
+
+	TArray<uint8> ActorData;
+
+	TArray<FComponentSnapshot> Components;
+};
+
+/** The initial state of all the resettable actors of a level */
+struct FLevelSnapshot
+{
+	TWeakObjectPtr<class ULevel> Level;
+
+	TArray<FActorSnapshot> Actors;
+};
+
+/**
+ * This system keeps the initial state of the resettable actors of registered levels in memory
+ * A snapshot is taken when the level has been added to the world after its package has loaded, restoring it resets the level without package IO
+ * A level that is hidden and shown again keeps the snapshot it had
+ * Resettable actors are guards, pickups, crates, doors, actors with destructibles and IResettableActorInterface implementers
+ */
+UCLASS()
+class CATASTROPHE_API ULevelSnapshotSubsystem : public UCatastropheGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ULevelSnapshotSubsystem();
+
+protected:
+
+	/** The levels that are snapshot when they are added to the world */
+	TSet<FName> ResettableLevelNames;
+
+	/** The snapshots by level name */
+	TMap<FName, FLevelSnapshot> LevelSnapshots;
+
+	FDelegateHandle LevelAddedToWorldHandle;
+
+	FDelegateHandle LevelRemovedFromWorldHandle;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/**
+	 * Register a level to be snapshot every time it is added to the world
+	 * @author Richard Wulansari
+	 * @param _levelName: The name of the streaming level
+	 * @param _bSnapshotIfVisible: Snapshot a level that is already visible immediately,
+	 * false if it has already been played and its snapshot has to wait for the next time it is added
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void RegisterResettableLevel(FName _levelName, bool _bSnapshotIfVisible = true);
+
+	/**
+	 * Restores the resettable actors of a level to their snapshot
+	 * Destroyed actors are respawned from the pool and resettable actors spawned into the level afterwards are destroyed
+	 * @author Richard Wulansari
+	 * @param _levelName: The name of the streaming level
+	 * @return False if there is no snapshot of the level, it has to be reloaded instead
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	bool RestoreLevel(FName _levelName);
+
+	/**
+	 * Check if a level can be restored from memory
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 */
+	UFUNCTION(BlueprintPure, Category = "Respawn System")
+	bool HasSnapshot(FName _levelName) const;
+
+	/** Gets the instance without going through the GameInstance */
+	static ULevelSnapshotSubsystem* GetInst(const UObject* _worldContextObject);
+
+protected:
+
+	/** Called when a snapshot actor is destroyed, prepares its replacement in the pool */
+	UFUNCTION()
+	void OnResettableActorDestroyed(AActor* _destroyedActor);
+
+private:
+
+	/** Called by the engine when a level has finished being added to a world */
+	void OnLevelAddedToWorld(class ULevel* _level, class UWorld* _world);
+
+	/** Called by the engine when a level has been removed from a world */
+	void OnLevelRemovedFromWorld(class ULevel* _level, class UWorld* _world);
+
+	/**
+	 * Records the state of all the resettable actors of a level
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 * @param _level
+	 */
+	void TakeSnapshot(FName _levelName, class ULevel* _level);
+
+	/** Writes the actor and its components into the snapshot */
+	static void SerializeActor(AActor* _actor, FActorSnapshot& _snapshot);
+
+	/** Restores the actor and its components from the snapshot */
+	static void DeserializeActor(AActor* _actor, const FActorSnapshot& _snapshot);
+
+	/** Gets the name of the registered streaming level a level belongs to, NAME_None if not registered */
+	FName FindResettableLevelName(class ULevel* _level) const;
+
+	/** Check if an actor is reset with its level */
+	static bool IsResettableActor(const AActor* _actor);
+
+};
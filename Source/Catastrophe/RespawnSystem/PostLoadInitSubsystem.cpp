@@ -0,0 +1,158 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PostLoadInitSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "HAL/PlatformTime.h"
+
+#include "StreamingLevelInterface.h"
+
+UPostLoadInitSubsystem::UPostLoadInitSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UPostLoadInitSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+		this, &UPostLoadInitSubsystem::OnLevelAddedToWorld);
+	bInitialized = true;
+}
+
+void UPostLoadInitSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+	OnWorkDrained.Clear();
+	bInitialized = false;
+	WorkQueue.Empty();
+	NextWorkIndex = 0;
+	PendingLevels.Empty();
+	AddedLevels.Empty();
+}
+
+void UPostLoadInitSubsystem::Tick(float DeltaTime)
+{
+	const double startTime = FPlatformTime::Seconds();
+	const double budgetSeconds = FrameBudgetMs / 1000.0f;
+
+	// At least one item runs each frame so the queue always drains
+	while (NextWorkIndex < WorkQueue.Num())
+	{
+		// Move the work out first, it may schedule more work and grow the queue
+		FPostLoadWorkItem workItem = MoveTemp(WorkQueue[NextWorkIndex]);
+		NextWorkIndex++;
+
+		if (workItem.Owner.IsValid() && workItem.Work)
+			workItem.Work();
+
+		if (FPlatformTime::Seconds() - startTime >= budgetSeconds)
+			break;
+	}
+
+	if (NextWorkIndex >= WorkQueue.Num())
+	{
+		WorkQueue.Reset();
+		NextWorkIndex = 0;
+		NotifyPendingLevelsLoaded();
+
+		// The callbacks may have queued more work, it is only drained once that has run too
+		if (IsIdle())
+			OnWorkDrained.Broadcast();
+	}
+}
+
+bool UPostLoadInitSubsystem::IsTickable() const
+{
+	// The class default object should never tick
+	return bInitialized &&
+		(GetPendingWorkCount() > 0 || PendingLevels.Num() > 0) &&
+		!HasAnyFlags(RF_ClassDefaultObject);
+}
+
+UWorld* UPostLoadInitSubsystem::GetTickableGameObjectWorld() const
+{
+	UGameInstance* gameInst = Cast<UGameInstance>(GetOuter());
+	return gameInst ? gameInst->GetWorld() : nullptr;
+}
+
+TStatId UPostLoadInitSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPostLoadInitSubsystem, STATGROUP_Tickables);
+}
+
+void UPostLoadInitSubsystem::ScheduleWork(UObject* _owner, TFunction<void()> _work)
+{
+	UPostLoadInitSubsystem* scheduler = GetInst(_owner);
+	if (!scheduler || !scheduler->bInitialized)
+	{
+		_work();
+		return;
+	}
+
+	FPostLoadWorkItem workItem;
+	workItem.Owner = _owner;
+	workItem.Work = MoveTemp(_work);
+	scheduler->WorkQueue.Add(MoveTemp(workItem));
+}
+
+UPostLoadInitSubsystem* UPostLoadInitSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UPostLoadInitSubsystem>();
+	}
+	return nullptr;
+}
+
+void UPostLoadInitSubsystem::OnLevelAddedToWorld(ULevel* _level, UWorld* _world)
+{
+	if (_world != GetTickableGameObjectWorld() || !_level || _level->IsPersistentLevel()) return;
+
+	// Only the first add after the package has loaded, a reloaded package is a new level object
+	if (AddedLevels.Contains(_level))
+		return;
+
+	// The unloaded levels are forgotten on the way
+	for (auto iterator = AddedLevels.CreateIterator(); iterator; ++iterator)
+	{
+		if (!iterator->IsValid())
+			iterator.RemoveCurrent();
+	}
+	AddedLevels.Add(_level);
+
+	PendingLevels.AddUnique(_level);
+}
+
+void UPostLoadInitSubsystem::NotifyPendingLevelsLoaded()
+{
+	// Copy, the callbacks may stream more levels
+	TArray<TWeakObjectPtr<ULevel>> loadedLevels = MoveTemp(PendingLevels);
+	PendingLevels.Reset();
+
+	for (const TWeakObjectPtr<ULevel>& level : loadedLevels)
+	{
+		if (!level.IsValid())
+			continue;
+
+		ALevelScriptActor* levelScript = level->GetLevelScriptActor();
+		if (!levelScript || !levelScript->GetClass()->ImplementsInterface(UStreamingLevelInterface::StaticClass()))
+			continue;
+
+		FLoadStreamingLevelInfo levelLoadedInfo;
+		const FString packageName = UWorld::RemovePIEPrefix(level->GetOutermost()->GetName());
+		levelLoadedInfo.OriginalLevelName = FName(*FPackageName::GetShortName(packageName));
+		levelLoadedInfo.LoadingLevelName = levelLoadedInfo.OriginalLevelName;
+		levelLoadedInfo.bTeleportPlayer = false;
+		IStreamingLevelInterface::Execute_OnStreamLevelLoaded(levelScript, levelLoadedInfo);
+	}
+}
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "PostLoadInitSubsystem.generated.h"
+
+/** A piece of initialization that has been deferred out of BeginPlay */
+struct FPostLoadWorkItem
+{
+	/** The work is skipped if the owner is gone */
+	TWeakObjectPtr<UObject> Owner;
+
+	TFunction<void()> Work;
+};
+
+/**
+ * This system spreads heavy initialization of newly streamed levels over several frames
+ * Actors schedule their heavy work from BeginPlay, it is processed under a per frame time budget
+ * Once the queue has drained, the level blueprints implementing IStreamingLevelInterface are told their level has loaded
+ * It only ticks while there is work or a level waiting for its callback
+ */
+UCLASS()
+class CATASTROPHE_API UPostLoadInitSubsystem : public UCatastropheGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UPostLoadInitSubsystem();
+
+	/** The time the queued work may take each frame in milliseconds, at least one item runs per frame */
+	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
+	float FrameBudgetMs = 2.0f;
+
+	/** Broadcast once the queue has drained and the loaded levels have been told, e.g. a district transition waits for it */
+	FSimpleMulticastDelegate OnWorkDrained;
+
+protected:
+
+	bool bInitialized = false;
+
+	TArray<FPostLoadWorkItem> WorkQueue;
+
+	/** The index of the next item, the queue is only compacted once it has drained */
+	int32 NextWorkIndex = 0;
+
+	/** The levels that has been added since the queue last drained */
+	TArray<TWeakObjectPtr<class ULevel>> PendingLevels;
+
+	/** The levels that has been added before, a hidden level that is shown again is not a new load */
+	TSet<TWeakObjectPtr<class ULevel>> AddedLevels;
+
+	FDelegateHandle LevelAddedToWorldHandle;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObject interface */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	/** FTickableGameObject interface End */
+
+	/**
+	 * Queues initialization work to run within the frame budget
+	 * @author Richard Wulansari
+	 * @param _owner The object the work belongs to, the work is skipped if it is gone
+	 * @param _work
+	 * @note Runs the work immediately if there is no scheduler, e.g. outside of a game
+	 */
+	static void ScheduleWork(UObject* _owner, TFunction<void()> _work);
+
+	/** Gets the instance without going through the GameInstance */
+	static UPostLoadInitSubsystem* GetInst(const UObject* _worldContextObject);
+
+	/** Getter */
+	FORCEINLINE int32 GetPendingWorkCount() const { return WorkQueue.Num() - NextWorkIndex; }
+	FORCEINLINE bool IsIdle() const { return GetPendingWorkCount() == 0 && PendingLevels.Num() == 0; }
+	/** Getter End */
+
+private:
+
+	/** Called by the engine when a level has finished being added to a world */
+	void OnLevelAddedToWorld(class ULevel* _level, class UWorld* _world);
+
+	/** Calls OnStreamLevelLoaded on the level blueprints of the pending levels */
+	void NotifyPendingLevelsLoaded();
+
+};
@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "ResettableActorInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(BlueprintType)
+class UResettableActorInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Actors implementing this interface are restored to their initial state when their level is reset
+ * Implement it for the actors that are not reset by default, or to clear runtime state after a restore
+ */
+class CATASTROPHE_API IResettableActorInterface
+{
+	GENERATED_BODY()
+
+	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
+public:
+
+	/**
+	 * Called after the properties of the actor has been restored from the snapshot of its level
+	 * Use this to clear the state that is not stored in properties, e.g. timers and running logic
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "LevelStreaming")
+	void OnSnapshotRestored();
+	virtual void OnSnapshotRestored_Implementation() {}
+
+};
@@ -33,6 +33,6 @@ void ARespawnPoint::PostInitializeComponents()
 	URespawnSubsystem* respawnSystem = URespawnSubsystem::GetInst(this);
 	if (respawnSystem)
 	{
-		respawnSystem->RegisterRespawnLocation(District, GetTransform(), LocationName);
+		respawnSystem->RegisterRespawnLocation(District, GetTransform(), LocationName, bCheckpoint);
 	}
 }
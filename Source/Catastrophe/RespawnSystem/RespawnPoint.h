@@ -31,6 +31,10 @@ protected:
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "RespawnSystem")
 	FString LocationName = "DefaultName";
 
+	/** Whether the player can be sent back here for a quick retry when failing nearby */
+	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "RespawnSystem")
+	bool bCheckpoint = false;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -12,13 +12,24 @@
 
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "NavigationSystem.h"
+#include "NavigationPath.h"
 #include "Kismet/KismetMathLibrary.h"
 
 #include "Characters/PlayerCharacter/PlayerCharacter.h"
 #include "StreamingLevelInterface.h"
+#include "StreamingTelemetrySubsystem.h"
+#include "LevelSnapshotSubsystem.h"
+#include "LevelResidencySubsystem.h"
+#include "DistrictPreloadSubsystem.h"
+#include "PostLoadInitSubsystem.h"
+#include "Gameplay/FadeEffectWidget.h"
 
 #include "DebugUtility/CatastropheDebug.h"
 
+/** The size of a grid cell of the respawn locations */
+#define RESPAWN_CELL_SIZE 5000.0f
 
 URespawnSubsystem::URespawnSubsystem() 
 	: UCatastropheGameInstanceSubsystem()
@@ -26,71 +37,109 @@ URespawnSubsystem::URespawnSubsystem()
 
 void URespawnSubsystem::RespawnPlayerAtDistrict_Internal(EDISTRICT _district, FString _locationName)
 {
-	FDistrictInfo districtInfo = Districts[(int32)_district];
+	const FDistrictInfo& districtInfo = Districts[(int32)_district];
 
 	// Set the temp values
-	tempLoadingDistrictInfo = districtInfo;
-	tempRespawnLocationName = _locationName;
-	tempCurrentLoadingLevel = 0;
-	tempCurrentUnLoadingLevel = 0;
+	tempLoadingDistrict = _district;
+	tempRespawnLocationName = FName(*_locationName);
 	tempLevelsToLoad.Empty();
-	tempLevelsToUnload.Empty();
+	tempLevelsLoading.Empty();
+	tempLevelsUnloading.Empty();
+	tempLevelsHiding.Empty();
+	tempLevelsResetting.Empty();
 
-	// Allocate task for levels needs to be unloaded and	loaded
+	ULevelSnapshotSubsystem* levelSnapshotSystem = GetOtherSubsytem<ULevelSnapshotSubsystem>();
+
+	// Only stream the difference between what is resident and what the district needs
+	// Levels shared between districts stay loaded, the visible ones are still reset like a fresh load
 	{
 		for (FName levelToLoad : districtInfo.LevelsToLoad)
 		{
-			ULevelStreaming* streamLevel =
-				UGameplayStatics::GetStreamingLevel(this, levelToLoad);
-			if (streamLevel)
+			ULevelStreaming* streamLevel = FindStreamingLevel(levelToLoad);
+			if (!streamLevel)
+				continue;
+
+			if (!streamLevel->IsLevelVisible())
+			{
+				tempLevelsToLoad.AddUnique(levelToLoad);
+
+				// A resident level that has been played keeps its snapshot while hidden, it is restored once it is shown
+				// A prefetched level that has never been shown has no snapshot, it is still in its loaded state
+				if (streamLevel->IsLevelLoaded() && levelSnapshotSystem && levelSnapshotSystem->HasSnapshot(levelToLoad))
+					tempLevelsResetting.AddUnique(levelToLoad);
+			}
+			else if (levelSnapshotSystem && levelSnapshotSystem->HasSnapshot(levelToLoad))
+			{
+				// e.g. the player has been caught and sent back into the same district, restored behind the fade
+				tempLevelsResetting.AddUnique(levelToLoad);
+			}
+			else
 			{
-				tempLevelsToLoad.Add(levelToLoad);
+				// Without a snapshot the level is reloaded, its load waits for its unload
+				tempLevelsUnloading.AddUnique(levelToLoad);
+				tempLevelsToLoad.AddUnique(levelToLoad);
 			}
 		}
 
+		TArray<FName> levelsNotNeeded;
 		for (FName levelName : StreamingLevels)
 		{
-			ULevelStreaming* streamLevel =
-				UGameplayStatics::GetStreamingLevel(this, levelName);
-			if (streamLevel && streamLevel->IsLevelLoaded())
+			if (districtInfo.LevelsToLoad.Contains(levelName))
+				continue;
+
+			ULevelStreaming* streamLevel = FindStreamingLevel(levelName);
+			if (!streamLevel || !streamLevel->IsLevelLoaded())
+				continue;
+
+			// Prefetched levels are only hidden, the player is still near the trigger that wants them
+			if (PrefetchReferences.Contains(levelName))
 			{
-				tempLevelsToUnload.Add(levelName);
+				if (streamLevel->ShouldBeVisible())
+					tempLevelsHiding.Add(levelName);
+				continue;
 			}
+
+			levelsNotNeeded.Add(levelName);
 		}
-	}
 
-	// Start the unloading and loading task
-	if (tempCurrentUnLoadingLevel < tempLevelsToUnload.Num())
-	{
-		FLatentActionInfo latenInfo;
-		latenInfo.CallbackTarget = this;
-		latenInfo.UUID = 0;
-		latenInfo.Linkage = 0;
-		latenInfo.ExecutionFunction = TEXT("OnDistrictRequireLevelUnloaded");
-		UGameplayStatics::UnloadStreamLevel(
-			this,
-			tempLevelsToUnload[tempCurrentUnLoadingLevel],
-			latenInfo,
-			bShouldBlockDuringEachLoad);
-	}
-	else if (tempCurrentLoadingLevel < tempLevelsToLoad.Num())
-	{
-		FLatentActionInfo latenInfo;
-		latenInfo.CallbackTarget = this;
-		latenInfo.UUID = 0;
-		latenInfo.Linkage = 0;
-		latenInfo.ExecutionFunction = TEXT("OnDistrictRequireLevelLoaded");
-		UGameplayStatics::LoadStreamLevel(
-			this,
-			tempLevelsToLoad[tempCurrentLoadingLevel],
-			true,
-			bShouldBlockDuringEachLoad,
-			latenInfo);
-	}
-	else
-	{
-		OnDisctrictLoaded(tempLoadingDistrictInfo, tempRespawnLocationName);
+		// Recently used levels stay loaded but hidden as long as they fit in the memory budget
+		TArray<FName> levelsToEvict;
+		if (ULevelResidencySubsystem* residency = GetOtherSubsytem<ULevelResidencySubsystem>())
+		{
+			residency->TouchLevels(districtInfo.LevelsToLoad);
+			residency->SelectLevelsToEvict(districtInfo.LevelsToLoad, levelsNotNeeded, levelsToEvict);
+		}
+		else
+		{
+			levelsToEvict = levelsNotNeeded;
+		}
+
+		for (FName levelName : levelsNotNeeded)
+		{
+			if (levelsToEvict.Contains(levelName))
+				tempLevelsUnloading.Add(levelName);
+			else if (FindStreamingLevel(levelName)->ShouldBeVisible())
+				tempLevelsHiding.Add(levelName);
+		}
+
+		ReleaseEvictedDistrictPreloads(_district, levelsToEvict);
 	}
+	tempPendingStreamingCount = tempLevelsToLoad.Num() + tempLevelsUnloading.Num();
+	bDistrictTransitionActive = true;
+
+	ApplyStreamingPolicy(districtInfo.StreamingPolicy);
+	PreloadDistrictAssets(_district);
+
+	if (UStreamingTelemetrySubsystem* telemetry = GetOtherSubsytem<UStreamingTelemetrySubsystem>())
+		telemetry->BeginTransition(_district);
+
+	// The levels the player may still see are only removed once the screen is black
+	if (bTransitionFadeOutComplete)
+		IssueDistrictUnloads();
+
+	// The loads are issued as soon as nothing they depend on is pending
+	IssueReadyDistrictLoads();
+	TryFinishDistrictTransition();
 }
 
 void URespawnSubsystem::Initialize(FSubsystemCollectionBase& Collection)
@@ -104,29 +153,53 @@ void URespawnSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		districtInfo.RespawnDistrictType = static_cast<EDISTRICT>(i);
 		Districts.Add(districtInfo);
 	}
+
+	// The cave is loaded during the chase, it gets the time it needs without long frames
+	FDistrictStreamingPolicy& cavePolicy = Districts[(int32)EDISTRICT::CAVE].StreamingPolicy;
+	cavePolicy.LoadPriority = 10;
+	cavePolicy.AsyncLoadingTimeLimitMs = 8.0f;
+	cavePolicy.AddToWorldTimeSliceMs = 3.0f;
+	cavePolicy.ComponentRegistrationGranularity = 5;
+
+	// The jail is entered on capture, the loading happens behind a black screen
+	Districts[(int32)EDISTRICT::JAIL].StreamingPolicy.bBlockOnLoad = true;
 }
 
 void URespawnSubsystem::PostInitialize()
 {
 	Super::PostInitialize();
 
+	// A district transition waits for the post load work of its levels before the screen fades back in
+	if (UPostLoadInitSubsystem* postLoadInit = GetOtherSubsytem<UPostLoadInitSubsystem>())
+	{
+		PostLoadWorkDrainedHandle = postLoadInit->OnWorkDrained.AddUObject(
+			this, &URespawnSubsystem::TryFinishDistrictTransition);
+	}
 }
 
 void URespawnSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 	
+	if (UPostLoadInitSubsystem* postLoadInit = GetOtherSubsytem<UPostLoadInitSubsystem>())
+		postLoadInit->OnWorkDrained.Remove(PostLoadWorkDrainedHandle);
+
+	RestoreStreamingSettings();
 }
 
 // Register level names, only valid level name will be registered
 void URespawnSubsystem::RegisterStreamingLevels(const TArray<FName> _levelNames)
 {
+	ULevelResidencySubsystem* residency = GetOtherSubsytem<ULevelResidencySubsystem>();
 	for (FName levelName : _levelNames)
 	{
-		if (ULevelStreaming* streamLevel = 
-			UGameplayStatics::GetStreamingLevel(this, levelName))
+		if (ULevelStreaming* streamLevel = FindStreamingLevel(levelName))
 		{
 			StreamingLevels.Add(levelName);
+
+			// Levels loaded outside of a district transition still count towards the budget
+			if (residency)
+				residency->RegisterLevel(levelName, streamLevel);
 		}
 	}
 }
@@ -137,13 +210,17 @@ void URespawnSubsystem::RegisterDistrict(EDISTRICT _district, TArray<FName> _lev
 	{
 		if (static_cast<EDISTRICT>(i) == _district)
 		{
+			ULevelSnapshotSubsystem* levelSnapshotSystem = GetOtherSubsytem<ULevelSnapshotSubsystem>();
 			for (FName levelName : _levelRequired)
 			{
-				ULevelStreaming* streamLevel =
-					UGameplayStatics::GetStreamingLevel(this, levelName);
+				ULevelStreaming* streamLevel = FindStreamingLevel(levelName);
 				if (streamLevel)
 				{
 					Districts[i].LevelsToLoad.Add(levelName);
+
+					// Entering the district again resets its levels from their snapshots
+					if (levelSnapshotSystem)
+						levelSnapshotSystem->RegisterResettableLevel(levelName);
 				}
 			}
 			break;
@@ -151,6 +228,34 @@ void URespawnSubsystem::RegisterDistrict(EDISTRICT _district, TArray<FName> _lev
 	}
 }
 
+void URespawnSubsystem::SetDistrictStreamingPolicy(EDISTRICT _district, FDistrictStreamingPolicy _policy)
+{
+	if (!Districts.IsValidIndex((int32)_district)) return;
+
+	Districts[(int32)_district].StreamingPolicy = _policy;
+}
+
+void URespawnSubsystem::RegisterDistrictPreloadAssets(EDISTRICT _district, TArray<TSoftObjectPtr<UObject>> _assets)
+{
+	if (!Districts.IsValidIndex((int32)_district)) return;
+
+	for (const TSoftObjectPtr<UObject>& asset : _assets)
+	{
+		if (!asset.IsNull())
+			Districts[(int32)_district].PreloadAssets.AddUnique(asset);
+	}
+}
+
+void URespawnSubsystem::RegisterLevelDependencies(FName _levelName, TArray<FName> _dependencies)
+{
+	TArray<FName>& dependencies = LevelDependencies.FindOrAdd(_levelName);
+	for (FName dependency : _dependencies)
+	{
+		if (dependency != _levelName)
+			dependencies.AddUnique(dependency);
+	}
+}
+
 void URespawnSubsystem::LoadLevelStreaming(FLoadStreamingLevelInfo _loadLevelInfo)
 {
 	// Store the temp value
@@ -197,19 +302,26 @@ void URespawnSubsystem::ResetStreamingLevel(FLoadStreamingLevelInfo _loadLevelIn
 	}
 
 	OnLevelTransitionStart.Broadcast();
-	FLatentActionInfo latenInfo;
-	latenInfo.CallbackTarget = this;
-	latenInfo.UUID = 3;
-	latenInfo.Linkage = 0;
-	latenInfo.ExecutionFunction = TEXT("OnStreamLevelResetUnloadFinish");
-	UGameplayStatics::UnloadStreamLevel(
-		this, 
-		_loadLevelInfo.OriginalLevelName,
-		latenInfo, 
-		false);
+
+	// Restore the level from memory if it has a snapshot, otherwise reload it and snapshot it on the way back
+	if (ULevelSnapshotSubsystem* levelSnapshotSystem = GetOtherSubsytem<ULevelSnapshotSubsystem>())
+	{
+		if (levelSnapshotSystem->HasSnapshot(_loadLevelInfo.OriginalLevelName))
+		{
+			// The actors jump back to their start, the player must not see it
+			bResetRestorePending = true;
+			StartTransitionFade();
+			return;
+		}
+
+		// The level is already played, its snapshot is taken when it is added back to the world
+		levelSnapshotSystem->RegisterResettableLevel(_loadLevelInfo.OriginalLevelName, false);
+	}
+
+	UnloadResetLevel();
 }
 
-void URespawnSubsystem::RegisterRespawnLocation(EDISTRICT _districtType, FTransform _transform, FString _locationName)
+void URespawnSubsystem::RegisterRespawnLocation(EDISTRICT _districtType, FTransform _transform, FString _locationName, bool _bCheckpoint)
 {
 	// Check if the district is valid
 	if ((int32)_districtType < 0 || (int32)_districtType >= (int32)EDISTRICT::COUNT)
@@ -223,11 +335,178 @@ void URespawnSubsystem::RegisterRespawnLocation(EDISTRICT _districtType, FTransf
 	// Force the scale to be 1 so the player respawn will never messed up
 	_transform.SetScale3D(FVector::OneVector);
 
-	// Store the location
-	FRespawnLocationInfo respawnLocationInfo;
+	// Store the location, a known name is replaced in place so its handle stays valid
+	FDistrictInfo& districtInfo = Districts[(int32)_districtType];
+	const FName locationName = FName(*_locationName);
+	FRespawnLocationHandle handle;
+	handle.District = _districtType;
+
+	if (const int32* index = districtInfo.RespawnLocationIndices.Find(locationName))
+	{
+		handle.Index = *index;
+
+		// Take it out of the cell it was in
+		const FIntPoint previousCell = GetRespawnCell(districtInfo.RespawnLocations[handle.Index].RespawnTransform.GetLocation());
+		if (TArray<FRespawnLocationHandle>* cellHandles = RespawnLocationCells.Find(previousCell))
+		{
+			cellHandles->RemoveAllSwap([&handle](const FRespawnLocationHandle& _other)
+			{
+				return _other.District == handle.District && _other.Index == handle.Index;
+			});
+			if (cellHandles->Num() <= 0)
+				RespawnLocationCells.Remove(previousCell);
+		}
+	}
+	else
+	{
+		handle.Index = districtInfo.RespawnLocations.AddDefaulted();
+		districtInfo.RespawnLocationIndices.Add(locationName, handle.Index);
+	}
+
+	FRespawnLocationInfo& respawnLocationInfo = districtInfo.RespawnLocations[handle.Index];
 	respawnLocationInfo.LocationName = _locationName;
 	respawnLocationInfo.RespawnTransform = _transform;
-	Districts[(int32)_districtType].RespawnLocations.Add(respawnLocationInfo);
+	respawnLocationInfo.District = _districtType;
+	respawnLocationInfo.bCheckpoint = _bCheckpoint;
+
+	const FIntPoint cell = GetRespawnCell(_transform.GetLocation());
+	if (RespawnLocationCells.Num() <= 0)
+	{
+		RespawnCellMin = cell;
+		RespawnCellMax = cell;
+	}
+	else
+	{
+		RespawnCellMin = FIntPoint(FMath::Min(RespawnCellMin.X, cell.X), FMath::Min(RespawnCellMin.Y, cell.Y));
+		RespawnCellMax = FIntPoint(FMath::Max(RespawnCellMax.X, cell.X), FMath::Max(RespawnCellMax.Y, cell.Y));
+	}
+	RespawnLocationCells.FindOrAdd(cell).Add(handle);
+}
+
+bool URespawnSubsystem::GetNearestRespawnLocation(FVector _location, FRespawnLocationInfo& _outLocation) const
+{
+	const FRespawnLocationInfo* respawnLocation = FindNearestRespawnLocation(_location);
+	if (!respawnLocation)
+		return false;
+
+	_outLocation = *respawnLocation;
+	return true;
+}
+
+bool URespawnSubsystem::GetNearestReachableCheckpoint(FVector _location, FRespawnLocationInfo& _outLocation) const
+{
+	const FRespawnLocationInfo* checkpoint = FindNearestReachableCheckpoint(_location);
+	if (!checkpoint)
+		return false;
+
+	_outLocation = *checkpoint;
+	return true;
+}
+
+const FRespawnLocationInfo* URespawnSubsystem::FindRespawnLocation(EDISTRICT _district, FName _locationName) const
+{
+	if (!Districts.IsValidIndex((int32)_district)) return nullptr;
+
+	const FDistrictInfo& districtInfo = Districts[(int32)_district];
+	const int32* index = districtInfo.RespawnLocationIndices.Find(_locationName);
+	return index ? &districtInfo.RespawnLocations[*index] : nullptr;
+}
+
+const FRespawnLocationInfo* URespawnSubsystem::FindNearestRespawnLocation(const FVector& _location, bool _bCheckpointsOnly) const
+{
+	if (RespawnLocationCells.Num() <= 0) return nullptr;
+
+	const FIntPoint originCell = GetRespawnCell(_location);
+	const int32 maxRing = FMath::Max(
+		FMath::Max(FMath::Abs(originCell.X - RespawnCellMin.X), FMath::Abs(originCell.X - RespawnCellMax.X)),
+		FMath::Max(FMath::Abs(originCell.Y - RespawnCellMin.Y), FMath::Abs(originCell.Y - RespawnCellMax.Y)));
+
+	const FRespawnLocationInfo* nearestLocation = nullptr;
+	float nearestDistSq = MAX_FLT;
+
+	// Search the rings of cells around the location outwards
+	for (int32 ring = 0; ring <= maxRing; ++ring)
+	{
+		// A location in this ring is at least the cells in between away
+		if (nearestLocation && FMath::Square((ring - 1) * RESPAWN_CELL_SIZE) > nearestDistSq)
+			break;
+
+		for (int32 x = -ring; x <= ring; ++x)
+		{
+			for (int32 y = -ring; y <= ring; ++y)
+			{
+				// Only the border of the ring
+				if (FMath::Max(FMath::Abs(x), FMath::Abs(y)) != ring)
+					continue;
+
+				const TArray<FRespawnLocationHandle>* cellHandles = RespawnLocationCells.Find(originCell + FIntPoint(x, y));
+				if (!cellHandles)
+					continue;
+
+				for (const FRespawnLocationHandle& handle : *cellHandles)
+				{
+					const FRespawnLocationInfo& respawnLocation = GetRespawnLocation(handle);
+					if (_bCheckpointsOnly && !respawnLocation.bCheckpoint)
+						continue;
+
+					const float distSq = FVector::DistSquared(_location, respawnLocation.RespawnTransform.GetLocation());
+					if (distSq < nearestDistSq)
+					{
+						nearestDistSq = distSq;
+						nearestLocation = &respawnLocation;
+					}
+				}
+			}
+		}
+	}
+
+	return nearestLocation;
+}
+
+const FRespawnLocationInfo* URespawnSubsystem::FindNearestReachableCheckpoint(const FVector& _location) const
+{
+	// Gather the checkpoints within the search radius
+	TArray<TPair<float, const FRespawnLocationInfo*>> candidates;
+	const float searchRadiusSq = FMath::Square(CheckpointSearchRadius);
+	const int32 cellRadius = FMath::CeilToInt(CheckpointSearchRadius / RESPAWN_CELL_SIZE);
+	const FIntPoint originCell = GetRespawnCell(_location);
+	for (int32 x = -cellRadius; x <= cellRadius; ++x)
+	{
+		for (int32 y = -cellRadius; y <= cellRadius; ++y)
+		{
+			const TArray<FRespawnLocationHandle>* cellHandles = RespawnLocationCells.Find(originCell + FIntPoint(x, y));
+			if (!cellHandles)
+				continue;
+
+			for (const FRespawnLocationHandle& handle : *cellHandles)
+			{
+				const FRespawnLocationInfo& respawnLocation = GetRespawnLocation(handle);
+				if (!respawnLocation.bCheckpoint)
+					continue;
+
+				const float distSq = FVector::DistSquared(_location, respawnLocation.RespawnTransform.GetLocation());
+				if (distSq <= searchRadiusSq)
+					candidates.Emplace(distSq, &respawnLocation);
+			}
+		}
+	}
+
+	candidates.Sort([](const TPair<float, const FRespawnLocationInfo*>& _a, const TPair<float, const FRespawnLocationInfo*>& _b)
+	{
+		return _a.Key < _b.Key;
+	});
+
+	// The nearest one with a complete path wins
+	const int32 testCount = FMath::Min(candidates.Num(), MaxCheckpointPathTests);
+	for (int32 i = 0; i < testCount; ++i)
+	{
+		UNavigationPath* path = UNavigationSystemV1::FindPathToLocationSynchronously(
+			GetWorld(), _location, candidates[i].Value->RespawnTransform.GetLocation());
+		if (path && path->IsValid() && !path->IsPartial())
+			return candidates[i].Value;
+	}
+
+	return nullptr;
 }
 
 FTransform URespawnSubsystem::GetFirstRespawnLocationAtDistrict(EDISTRICT _districtType)
@@ -241,16 +520,16 @@ FTransform URespawnSubsystem::GetFirstRespawnLocationAtDistrict(EDISTRICT _distr
 	}
 
 	// Check if there is any locations registered
-	TArray<FTransform> respawnPointsInDistrict; //= RespawnPoints[_districtType].RespawnTransforms;
-// 	if (respawnPointsInDistrict.Num() <= 0)
-// 	{
-// 		UE_LOG(LogTemp, Error,
-// 			TEXT("Unable to find respawn location cause there is no location in district"));
-// 		return FTransform::Identity;
-// 	}
+	const TArray<FRespawnLocationInfo>& respawnLocations = Districts[(int32)_districtType].RespawnLocations;
+	if (respawnLocations.Num() <= 0)
+	{
+		UE_LOG(LogTemp, Error,
+			TEXT("Unable to find respawn location cause there is no location in district"));
+		return FTransform::Identity;
+	}
 
 	// Give the transform
-	return respawnPointsInDistrict[0];
+	return respawnLocations[0].RespawnTransform;
 }
 
 void URespawnSubsystem::RespawnPlayerAtLocation(EDISTRICT _districtType)
@@ -282,11 +561,84 @@ void URespawnSubsystem::RespawnPlayerAtDistrict(EDISTRICT _district, FString _lo
 {
 	OnLevelTransitionStart.Broadcast();
 
-	FTimerHandle timerHandle;
-	FTimerDelegate timerDele;
-	timerDele.BindUFunction(this, FName("RespawnPlayerAtDistrict_Internal"), _district, _locationName);
-	float timeDilation = UGameplayStatics::GetGlobalTimeDilation(this);
-	GetWorld()->GetTimerManager().SetTimer(timerHandle, timerDele, 1.0f * timeDilation, false);
+	// The fade out and the loading run at the same time, the player is moved once both are done
+	StartTransitionFade();
+
+	RespawnPlayerAtDistrict_Internal(_district, _locationName);
+}
+
+void URespawnSubsystem::RegisterTransitionFadeWidget(UFadeEffectWidget* _fadeWidget)
+{
+	if (TransitionFadeWidget)
+		TransitionFadeWidget->OnEffectFinish.RemoveDynamic(this, &URespawnSubsystem::OnTransitionFadeOutFinished);
+
+	TransitionFadeWidget = _fadeWidget;
+
+	if (TransitionFadeWidget)
+		TransitionFadeWidget->OnEffectFinish.AddUniqueDynamic(this, &URespawnSubsystem::OnTransitionFadeOutFinished);
+}
+
+bool URespawnSubsystem::PrefetchDistrict(EDISTRICT _district)
+{
+	if (!Districts.IsValidIndex((int32)_district)) return false;
+
+	// A prefetch is only a guess, it must not push the loaded levels over the memory budget
+	ULevelResidencySubsystem* residency = GetOtherSubsytem<ULevelResidencySubsystem>();
+	if (residency && !residency->HasRoomFor(Districts[(int32)_district].LevelsToLoad))
+	{
+		UE_LOG(LogTemp, Log, TEXT("RespawnSystem: Skipped a district prefetch, it does not fit in the residency budget"));
+		return false;
+	}
+
+	for (FName levelName : Districts[(int32)_district].LevelsToLoad)
+	{
+		int32& references = PrefetchReferences.FindOrAdd(levelName);
+		++references;
+		if (references > 1)
+			continue;
+
+		// Levels that are already requested, e.g. the current district, are left alone
+		ULevelStreaming* streamLevel = FindStreamingLevel(levelName);
+		if (streamLevel && !streamLevel->ShouldBeLoaded())
+		{
+			UGameplayStatics::LoadStreamLevel(
+				this, levelName, false, false, MakeStreamingLatentInfo(NAME_None));
+		}
+	}
+	return true;
+}
+
+void URespawnSubsystem::ReleasePrefetchedDistrict(EDISTRICT _district)
+{
+	if (!Districts.IsValidIndex((int32)_district)) return;
+
+	for (FName levelName : Districts[(int32)_district].LevelsToLoad)
+	{
+		int32* references = PrefetchReferences.Find(levelName);
+		if (!references)
+			continue;
+
+		--(*references);
+		if (*references > 0)
+			continue;
+
+		PrefetchReferences.Remove(levelName);
+
+		// The transition is about to show it
+		if (bDistrictTransitionActive &&
+			(tempLevelsToLoad.Contains(levelName) || tempLevelsLoading.Contains(levelName)))
+		{
+			continue;
+		}
+
+		// Only the levels that were never shown are released
+		ULevelStreaming* streamLevel = FindStreamingLevel(levelName);
+		if (streamLevel && streamLevel->ShouldBeLoaded() && !streamLevel->ShouldBeVisible())
+		{
+			UGameplayStatics::UnloadStreamLevel(
+				this, levelName, MakeStreamingLatentInfo(NAME_None), false);
+		}
+	}
 }
 
 URespawnSubsystem* URespawnSubsystem::GetInst(const UObject* _worldContextObject)
@@ -371,68 +723,367 @@ void URespawnSubsystem::OnStreamLevelResetReloadFinish()
 	}
 }
 
-void URespawnSubsystem::OnDistrictRequireLevelLoaded()
+void URespawnSubsystem::UnloadResetLevel()
+{
+	FLatentActionInfo latenInfo;
+	latenInfo.CallbackTarget = this;
+	latenInfo.UUID = 3;
+	latenInfo.Linkage = 0;
+	latenInfo.ExecutionFunction = TEXT("OnStreamLevelResetUnloadFinish");
+	UGameplayStatics::UnloadStreamLevel(
+		this, 
+		tempInfo.OriginalLevelName,
+		latenInfo, 
+		false);
+}
+
+void URespawnSubsystem::RestoreResetLevel()
 {
-	tempCurrentLoadingLevel++;
-	if (tempCurrentLoadingLevel < tempLevelsToLoad.Num())
+	ULevelSnapshotSubsystem* levelSnapshotSystem = GetOtherSubsytem<ULevelSnapshotSubsystem>();
+	if (levelSnapshotSystem && levelSnapshotSystem->RestoreLevel(tempInfo.OriginalLevelName))
 	{
-		FLatentActionInfo latenInfo;
-		latenInfo.CallbackTarget = this;
-		latenInfo.UUID = 0;
-		latenInfo.Linkage = 0;
-		latenInfo.ExecutionFunction = TEXT("OnDistrictRequireLevelUnloaded");
-		UGameplayStatics::LoadStreamLevel(
-			this,
-			tempLevelsToLoad[tempCurrentLoadingLevel],
-			true,
-			bShouldBlockDuringEachLoad,
-			latenInfo);
+		// Listeners still get the unload and load pair of a reset
+		OnLevelUnLoaded.Broadcast(tempInfo);
+		OnStreamLevelResetReloadFinish();
+		return;
+	}
+
+	// The level has been removed during the fade, e.g. by a district transition
+	if (levelSnapshotSystem)
+		levelSnapshotSystem->RegisterResettableLevel(tempInfo.OriginalLevelName, false);
+	UnloadResetLevel();
+}
+
+void URespawnSubsystem::StartTransitionFade()
+{
+	bTransitionFadeOutComplete = false;
+	if (TransitionFadeWidget && TransitionFadeWidget->IsInViewport())
+	{
+		TransitionFadeWidget->StartFade(TransitionFadeOutTime);
 	}
 	else
 	{
-		OnDisctrictLoaded(tempLoadingDistrictInfo, tempRespawnLocationName);
+		// Nothing reports the end of the fade, assume it takes the fade out time
+		FTimerDelegate timerDele;
+		timerDele.BindUObject(this, &URespawnSubsystem::OnTransitionFadeOutFinished);
+		float timeDilation = UGameplayStatics::GetGlobalTimeDilation(this);
+		GetWorld()->GetTimerManager().SetTimer(
+			TransitionFadeTimerHandle, timerDele, TransitionFadeOutTime * timeDilation, false);
+	}
+}
+
+void URespawnSubsystem::OnDistrictRequireLevelLoaded()
+{
+	if (!bDistrictTransitionActive) return;
+
+	UStreamingTelemetrySubsystem* telemetry = GetOtherSubsytem<UStreamingTelemetrySubsystem>();
+	ULevelResidencySubsystem* residency = GetOtherSubsytem<ULevelResidencySubsystem>();
+
+	// The callback does not tell which level finished, check the ones in flight
+	for (int32 i = tempLevelsLoading.Num() - 1; i >= 0; --i)
+	{
+		ULevelStreaming* streamLevel = FindStreamingLevel(tempLevelsLoading[i]);
+		if (!streamLevel || streamLevel->IsLevelVisible())
+		{
+			if (telemetry)
+				telemetry->RecordLevelVisible(tempLevelsLoading[i]);
+			if (residency && streamLevel)
+				residency->NotifyLevelVisible(tempLevelsLoading[i], streamLevel);
+
+			tempLevelsLoading.RemoveAt(i);
+			tempPendingStreamingCount--;
+		}
 	}
+
+	IssueReadyDistrictLoads();
+	TryFinishDistrictTransition();
 }
 
 void URespawnSubsystem::OnDistrictRequireLevelUnloaded()
 {
-	tempCurrentUnLoadingLevel++;
-	if (tempCurrentUnLoadingLevel < tempLevelsToUnload.Num())
+	if (!bDistrictTransitionActive) return;
+
+	for (int32 i = tempLevelsUnloading.Num() - 1; i >= 0; --i)
 	{
-		FLatentActionInfo latenInfo;
-		latenInfo.CallbackTarget = this;
-		latenInfo.UUID = 0;
-		latenInfo.Linkage = 0;
-		latenInfo.ExecutionFunction = TEXT("OnDistrictRequireLevelUnloaded");
-		UGameplayStatics::UnloadStreamLevel(
-			this,
-			tempLevelsToUnload[tempCurrentUnLoadingLevel],
-			latenInfo,
-			bShouldBlockDuringEachLoad);
+		ULevelStreaming* streamLevel = FindStreamingLevel(tempLevelsUnloading[i]);
+		if (!streamLevel || !streamLevel->IsLevelLoaded())
+		{
+			tempLevelsUnloading.RemoveAt(i);
+			tempPendingStreamingCount--;
+		}
 	}
-	else if (tempCurrentLoadingLevel < tempLevelsToLoad.Num())
+
+	// A level that is reloaded waits for its own unload
+	IssueReadyDistrictLoads();
+	TryFinishDistrictTransition();
+}
+
+void URespawnSubsystem::IssueReadyDistrictLoads()
+{
+	// A blocking load freezes the frame, it has to wait until the screen is black
+	if (Districts[(int32)tempLoadingDistrict].StreamingPolicy.bBlockOnLoad && !bTransitionFadeOutComplete)
+		return;
+
+	for (int32 i = 0; i < tempLevelsToLoad.Num(); )
+	{
+		const FName levelName = tempLevelsToLoad[i];
+		if (!CanIssueDistrictLoad(levelName))
+		{
+			++i;
+			continue;
+		}
+
+		tempLevelsToLoad.RemoveAt(i);
+		IssueDistrictLoad(levelName);
+	}
+
+	// Nothing is in flight but levels are still waiting, the dependencies must be circular
+	if (tempLevelsToLoad.Num() > 0 &&
+		tempLevelsLoading.Num() == 0 &&
+		tempLevelsUnloading.Num() == 0)
+	{
+		CatastropheDebug::OnScreenErrorMsg(TEXT("RespawnSystem: Circular level dependencies, loading the rest without order"));
+		UE_LOG(LogTemp, Error, TEXT("RespawnSystem: Circular level dependencies, loading the rest without order"));
+		for (FName levelName : tempLevelsToLoad)
+		{
+			IssueDistrictLoad(levelName);
+		}
+		tempLevelsToLoad.Empty();
+	}
+}
+
+void URespawnSubsystem::IssueDistrictLoad(FName _levelName)
+{
+	tempLevelsLoading.Add(_levelName);
+
+	const FDistrictStreamingPolicy& policy = Districts[(int32)tempLoadingDistrict].StreamingPolicy;
+	ULevelStreaming* streamLevel = FindStreamingLevel(_levelName);
+
+	// A level shared between districts takes the priority of the district being loaded
+	if (streamLevel)
+		streamLevel->SetPriority(policy.LoadPriority);
+
+	if (UStreamingTelemetrySubsystem* telemetry = GetOtherSubsytem<UStreamingTelemetrySubsystem>())
+		telemetry->RecordLevelRequested(_levelName, streamLevel);
+
+	UGameplayStatics::LoadStreamLevel(
+		this,
+		_levelName,
+		true,
+		policy.bBlockOnLoad,
+		MakeStreamingLatentInfo(TEXT("OnDistrictRequireLevelLoaded")));
+}
+
+bool URespawnSubsystem::CanIssueDistrictLoad(FName _levelName) const
+{
+	if (tempLevelsUnloading.Contains(_levelName))
+		return false;
+
+	if (const TArray<FName>* dependencies = LevelDependencies.Find(_levelName))
+	{
+		for (FName dependency : *dependencies)
+		{
+			if (tempLevelsToLoad.Contains(dependency) || tempLevelsLoading.Contains(dependency))
+				return false;
+		}
+	}
+	return true;
+}
+
+void URespawnSubsystem::IssueDistrictUnloads()
+{
+	for (FName levelName : tempLevelsHiding)
 	{
-		FLatentActionInfo latenInfo;
-		latenInfo.CallbackTarget = this;
-		latenInfo.UUID = 0;
-		latenInfo.Linkage = 0;
-		latenInfo.ExecutionFunction = TEXT("OnDistrictRequireLevelLoaded");
 		UGameplayStatics::LoadStreamLevel(
+			this, levelName, false, false, MakeStreamingLatentInfo(NAME_None));
+	}
+	tempLevelsHiding.Empty();
+
+	// All the unloads are independent, issue them at once
+	for (FName levelName : tempLevelsUnloading)
+	{
+		UGameplayStatics::UnloadStreamLevel(
 			this,
-			tempLevelsToLoad[tempCurrentLoadingLevel],
-			true,
-			bShouldBlockDuringEachLoad,
-			latenInfo);
+			levelName,
+			MakeStreamingLatentInfo(TEXT("OnDistrictRequireLevelUnloaded")),
+			false);
 	}
-	else
+}
+
+void URespawnSubsystem::OnTransitionFadeOutFinished()
+{
+	if (bTransitionFadeOutComplete) return;
+
+	bTransitionFadeOutComplete = true;
+	GetWorld()->GetTimerManager().ClearTimer(TransitionFadeTimerHandle);
+
+	if (bResetRestorePending)
+	{
+		bResetRestorePending = false;
+		RestoreResetLevel();
+	}
+
+	if (bDistrictTransitionActive)
+	{
+		IssueDistrictUnloads();
+		IssueReadyDistrictLoads();
+		TryFinishDistrictTransition();
+	}
+}
+
+void URespawnSubsystem::ApplyStreamingPolicy(const FDistrictStreamingPolicy& _policy)
+{
+	auto overrideSetting = [this](const TCHAR* _name, const FString& _value)
+	{
+		IConsoleVariable* setting = IConsoleManager::Get().FindConsoleVariable(_name);
+		if (!setting)
+			return;
+
+		tempOverriddenStreamingSettings.Add(_name, setting->GetString());
+		setting->Set(*_value, ECVF_SetByCode);
+	};
+
+	// The policy of a previous district does not carry over
+	RestoreStreamingSettings();
+
+	if (_policy.AsyncLoadingTimeLimitMs > 0.0f)
+		overrideSetting(TEXT("s.AsyncLoadingTimeLimit"), FString::SanitizeFloat(_policy.AsyncLoadingTimeLimitMs));
+
+	if (_policy.AddToWorldTimeSliceMs > 0.0f)
+		overrideSetting(TEXT("s.LevelStreamingActorsUpdateTimeLimit"), FString::SanitizeFloat(_policy.AddToWorldTimeSliceMs));
+
+	if (_policy.ComponentRegistrationGranularity > 0)
+		overrideSetting(TEXT("s.LevelStreamingComponentsRegistrationGranularity"), FString::FromInt(_policy.ComponentRegistrationGranularity));
+}
+
+void URespawnSubsystem::RestoreStreamingSettings()
+{
+	for (const TPair<FString, FString>& overriddenSetting : tempOverriddenStreamingSettings)
+	{
+		if (IConsoleVariable* setting = IConsoleManager::Get().FindConsoleVariable(*overriddenSetting.Key))
+			setting->Set(*overriddenSetting.Value, ECVF_SetByCode);
+	}
+	tempOverriddenStreamingSettings.Empty();
+}
+
+void URespawnSubsystem::PreloadDistrictAssets(EDISTRICT _district)
+{
+	UDistrictPreloadSubsystem* preloadSystem = GetOtherSubsytem<UDistrictPreloadSubsystem>();
+	if (!preloadSystem || !Districts.IsValidIndex((int32)_district)) return;
+
+	TArray<FSoftObjectPath> assetPaths;
+	assetPaths.Reserve(Districts[(int32)_district].PreloadAssets.Num());
+	for (const TSoftObjectPtr<UObject>& asset : Districts[(int32)_district].PreloadAssets)
+	{
+		assetPaths.Add(asset.ToSoftObjectPath());
+	}
+	preloadSystem->RequestPreload(_district, assetPaths);
+}
+
+void URespawnSubsystem::ReleaseEvictedDistrictPreloads(EDISTRICT _district, const TArray<FName>& _levelsToEvict)
+{
+	UDistrictPreloadSubsystem* preloadSystem = GetOtherSubsytem<UDistrictPreloadSubsystem>();
+	if (!preloadSystem) return;
+
+	const FDistrictInfo& districtInfo = Districts[(int32)_district];
+	for (int32 i = 0; i < (int32)EDISTRICT::COUNT; ++i)
+	{
+		if (i == (int32)_district)
+			continue;
+
+		// The assets are kept while any level of the district stays resident, it is likely to be entered again
+		bool bResident = false;
+		for (FName levelName : Districts[i].LevelsToLoad)
+		{
+			if (_levelsToEvict.Contains(levelName))
+				continue;
+
+			ULevelStreaming* streamLevel = FindStreamingLevel(levelName);
+			if (districtInfo.LevelsToLoad.Contains(levelName) || (streamLevel && streamLevel->IsLevelLoaded()))
+			{
+				bResident = true;
+				break;
+			}
+		}
+
+		if (!bResident)
+			preloadSystem->ReleasePreload(static_cast<EDISTRICT>(i));
+	}
+}
+
+void URespawnSubsystem::CollectDistrictPreloadAssets(EDISTRICT _district)
+{
+	if (!Districts.IsValidIndex((int32)_district)) return;
+
+	FDistrictInfo& districtInfo = Districts[(int32)_district];
+	if (districtInfo.bPreloadAssetsCollected) return;
+
+	TArray<FSoftObjectPath> assetPaths;
+	for (FName levelName : districtInfo.LevelsToLoad)
+	{
+		ULevelStreaming* streamLevel = FindStreamingLevel(levelName);
+		if (streamLevel && streamLevel->GetLoadedLevel())
+			UDistrictPreloadSubsystem::CollectLevelPreloadAssets(streamLevel->GetLoadedLevel(), assetPaths);
+	}
+	districtInfo.bPreloadAssetsCollected = true;
+
+	const int32 previousAssetCount = districtInfo.PreloadAssets.Num();
+	for (const FSoftObjectPath& assetPath : assetPaths)
 	{
-		OnDisctrictLoaded(tempLoadingDistrictInfo, tempRespawnLocationName);
+		districtInfo.PreloadAssets.AddUnique(TSoftObjectPtr<UObject>(assetPath));
+	}
+
+	// Hold the new assets too while the district is resident
+	if (districtInfo.PreloadAssets.Num() > previousAssetCount)
+		PreloadDistrictAssets(_district);
+}
+
+void URespawnSubsystem::TryFinishDistrictTransition()
+{
+	// The player is only moved while the screen is black
+	if (!bDistrictTransitionActive || tempPendingStreamingCount > 0 || !bTransitionFadeOutComplete)
+		return;
+
+	// The district is reset while the screen is still black, before the player is moved into it
+	ULevelSnapshotSubsystem* levelSnapshotSystem = GetOtherSubsytem<ULevelSnapshotSubsystem>();
+	for (FName levelName : tempLevelsResetting)
+	{
+		if (!levelSnapshotSystem || !levelSnapshotSystem->RestoreLevel(levelName))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RespawnSystem: %s has lost its snapshot during the transition, it has not been reset"), *levelName.ToString());
+		}
 	}
+	tempLevelsResetting.Empty();
+
+	// The heavy initialization of the new levels is spread over frames, e.g. the procedural meshes
+	// The screen stays black until it is done, this is called again once the queue has drained
+	UPostLoadInitSubsystem* postLoadInit = GetOtherSubsytem<UPostLoadInitSubsystem>();
+	if (postLoadInit && !postLoadInit->IsIdle())
+		return;
+
+	bDistrictTransitionActive = false;
+	RestoreStreamingSettings();
+	CollectDistrictPreloadAssets(tempLoadingDistrict);
+
+	if (UStreamingTelemetrySubsystem* telemetry = GetOtherSubsytem<UStreamingTelemetrySubsystem>())
+		telemetry->EndTransition();
+
+	OnDisctrictLoaded(tempLoadingDistrict, tempRespawnLocationName);
+}
+
+FLatentActionInfo URespawnSubsystem::MakeStreamingLatentInfo(FName _executionFunction)
+{
+	FLatentActionInfo latenInfo;
+	latenInfo.CallbackTarget = this;
+	latenInfo.UUID = NextStreamingRequestUUID++;
+	latenInfo.Linkage = 0;
+	latenInfo.ExecutionFunction = _executionFunction;
+	return latenInfo;
 }
 
-void URespawnSubsystem::OnDisctrictLoaded(FDistrictInfo _loadingDistrictInfo, FString _respawnLocationName)
+void URespawnSubsystem::OnDisctrictLoaded(EDISTRICT _district, FName _respawnLocationName)
 {
-	FTransform respawnTransform = GetRespawnTransform(_loadingDistrictInfo, _respawnLocationName);
+	const FTransform& respawnTransform = GetRespawnTransform(Districts[(int32)_district], _respawnLocationName);
 	ACharacter* player = UGameplayStatics::GetPlayerCharacter(this, 0);
 	if (IsValid(player))
 	{
@@ -448,22 +1099,36 @@ void URespawnSubsystem::OnDisctrictLoaded(FDistrictInfo _loadingDistrictInfo, FS
 }
 
 // Gets the respawn transform by location name
-FTransform URespawnSubsystem::GetRespawnTransform(FDistrictInfo _loadingDistrictInfo, FString _respawnLocationName) const
+const FTransform& URespawnSubsystem::GetRespawnTransform(const FDistrictInfo& _loadingDistrictInfo, FName _respawnLocationName) const
 {
-	TArray<FRespawnLocationInfo> respawnLocations = _loadingDistrictInfo.RespawnLocations;
-	for (int32 i = 0; i < respawnLocations.Num(); ++i)
+	if (const int32* index = _loadingDistrictInfo.RespawnLocationIndices.Find(_respawnLocationName))
 	{
-		if (respawnLocations[i].LocationName == _respawnLocationName)
-		{
-			return respawnLocations[i].RespawnTransform;
-		}
+		return _loadingDistrictInfo.RespawnLocations[*index].RespawnTransform;
 	}
 
 	// If cannot find the transform specified
 	// either return the first in the array or otherwise return identity transform
-	if (respawnLocations.Num() > 0)
+	if (_loadingDistrictInfo.RespawnLocations.Num() > 0)
 	{
-		return respawnLocations[0].RespawnTransform;
+		return _loadingDistrictInfo.RespawnLocations[0].RespawnTransform;
 	}
 	else return FTransform::Identity;
 }
+
+FIntPoint URespawnSubsystem::GetRespawnCell(const FVector& _location)
+{
+	return FIntPoint(
+		FMath::FloorToInt(_location.X / RESPAWN_CELL_SIZE),
+		FMath::FloorToInt(_location.Y / RESPAWN_CELL_SIZE));
+}
+
+ULevelStreaming* URespawnSubsystem::FindStreamingLevel(FName _levelName) const
+{
+	// The handles belong to the world, look them up again after the world has changed
+	TWeakObjectPtr<ULevelStreaming>& handle = StreamingLevelHandles.FindOrAdd(_levelName);
+	if (!handle.IsValid() || handle->GetWorld() != GetWorld())
+	{
+		handle = UGameplayStatics::GetStreamingLevel(this, _levelName);
+	}
+	return handle.Get();
+}
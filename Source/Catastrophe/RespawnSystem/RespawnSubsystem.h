@@ -11,6 +11,14 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FLevelTransitionSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FLevelStreamSignatureOneParam, const FLoadStreamingLevelInfo, _info);
 
+/** Where a respawn location is stored, it stays valid as the locations are never removed */
+struct FRespawnLocationHandle
+{
+	EDISTRICT District;
+
+	int32 Index;
+};
+
 /**
  * This system controls the spawn of the player
  */
@@ -27,23 +35,64 @@ private:
 
 	/** Multi level loading support */
 
-	FDistrictInfo tempLoadingDistrictInfo;
+	EDISTRICT tempLoadingDistrict = EDISTRICT::HUB;
 
-	FString tempRespawnLocationName = TEXT("DefaultName");
+	FName tempRespawnLocationName = NAME_None;
 
-	bool bShouldBlockDuringEachLoad = true;
+	/** Levels that are waiting for their dependencies before they can start loading */
+	TArray<FName> tempLevelsToLoad;
 
-	int32 tempTotalUnLoadingLevel = 0;
+	/** Levels that has been requested to load and are not visible yet */
+	TArray<FName> tempLevelsLoading;
 
-	int32 tempCurrentUnLoadingLevel = 0;
+	/** Levels that has to be unloaded, they are requested once the fade out is complete */
+	TArray<FName> tempLevelsUnloading;
 
-	int32 tempTotalLoadingLevel = 0;
+	/** Prefetched levels that has to be hidden once the fade out is complete */
+	TArray<FName> tempLevelsHiding;
 
-	int32 tempCurrentLoadingLevel = 0;
+	/** Levels of the district that has been played, they are restored from their snapshots before the player is moved */
+	TArray<FName> tempLevelsResetting;
 
-	TArray<FName> tempLevelsToLoad;
+	/** Number of loads and unloads of the transition that has not finished, the district is loaded at zero */
+	int32 tempPendingStreamingCount = 0;
+
+	/** True while a district transition is waiting on its streaming requests */
+	bool bDistrictTransitionActive = false;
+
+	/** False while the screen is fading out for a district transition */
+	bool bTransitionFadeOutComplete = true;
+
+	/** Stands in for the end of the fade when no fade widget is registered */
+	FTimerHandle TransitionFadeTimerHandle;
+
+	/** True while a level reset is waiting for the screen to be black before it restores the snapshot */
+	bool bResetRestorePending = false;
+
+	/** The binding to the post load work queue, a transition finishes once it has drained */
+	FDelegateHandle PostLoadWorkDrainedHandle;
+
+	/** The engine streaming settings the district policy has overridden, by console variable name */
+	TMap<FString, FString> tempOverriddenStreamingSettings;
+
+	/** Each streaming request needs its own latent action, so they can run at the same time */
+	int32 NextStreamingRequestUUID = 100;
+
+	/** The levels that has to be visible before a level starts loading, e.g. geometry before gameplay */
+	TMap<FName, TArray<FName>> LevelDependencies;
+
+	/** The streaming level objects by name, so the level list of the world is not searched for every request */
+	mutable TMap<FName, TWeakObjectPtr<class ULevelStreaming>> StreamingLevelHandles;
 
-	TArray<FName> tempLevelsToUnload;
+	/** The number of prefetches that want a level to stay loaded in the background */
+	TMap<FName, int32> PrefetchReferences;
+
+	/** The respawn locations of all the districts by the grid cell they are in */
+	TMap<FIntPoint, TArray<FRespawnLocationHandle>> RespawnLocationCells;
+
+	/** The range of the grid cells that has been used */
+	FIntPoint RespawnCellMin;
+	FIntPoint RespawnCellMax;
 
 	/** =============================== */
 
@@ -65,6 +114,18 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Respawn System")
 	FLevelStreamSignatureOneParam OnLevelUnLoaded;
 
+	/** How long the screen takes to fade out at the start of a district transition */
+	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
+	float TransitionFadeOutTime = 1.0f;
+
+	/** How far a checkpoint may be to be used for a quick retry */
+	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
+	float CheckpointSearchRadius = 10000.0f;
+
+	/** The number of nearest checkpoints tested for a path, the path finding is synchronous */
+	UPROPERTY(BlueprintReadWrite, Category = "Respawn System")
+	int32 MaxCheckpointPathTests = 8;
+
 protected:
 
 	/** All the respawn locations that gets registered */
@@ -74,6 +135,10 @@ protected:
 	UPROPERTY()
 	TArray<FName> StreamingLevels;
 
+	/** The widget that fades the screen out during a district transition */
+	UPROPERTY()
+	class UFadeEffectWidget* TransitionFadeWidget;
+
 private:
 
 	/**
@@ -97,6 +162,7 @@ public:
 	 * Register levels that will be stored inside this respawn system
 	 * @author Richard Wulansari
 	 * @param _levelNames: Array of name of levels thats gonna be registered
+	 * @note The levels are also counted by the residency budget from here on, whoever loads them
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Respawn System")
 	void RegisterStreamingLevels(const TArray<FName> _levelNames);
@@ -106,10 +172,40 @@ public:
 	 * @author Richard Wulansari
 	 * @param _district: The district that it is register under
 	 * @param _levelRequired: The levels that required to load when loading the district
+	 * @note The levels are registered as resettable, they are reset every time the district is entered
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Respawn System")
 	void RegisterDistrict(EDISTRICT _district, TArray<FName> _levelRequired);
 
+	/**
+	 * Sets how the levels of a district are streamed
+	 * @author Richard Wulansari
+	 * @param _district
+	 * @param _policy: Applied while the district is being loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void SetDistrictStreamingPolicy(EDISTRICT _district, FDistrictStreamingPolicy _policy);
+
+	/**
+	 * Register the assets a district loads in the background during its transition
+	 * @author Richard Wulansari
+	 * @param _district
+	 * @param _assets: e.g. the guard blueprints, the effects and the sounds spawned in the district
+	 * @note The assets used by the district levels are added after the first time the district is loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void RegisterDistrictPreloadAssets(EDISTRICT _district, TArray<TSoftObjectPtr<UObject>> _assets);
+
+	/**
+	 * Register the levels a level depends on, it only starts loading after they are visible
+	 * @author Richard Wulansari
+	 * @param _levelName: The dependent level
+	 * @param _dependencies: The levels that has to be loaded first, e.g. the geometry and the lighting sublevels
+	 * @note Only dependencies that are loaded in the same transition are waited on
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void RegisterLevelDependencies(FName _levelName, TArray<FName> _dependencies);
+
 	/**
 	 * Load the level inside the level streaming world
 	 * @author Richard Wulansari
@@ -132,6 +228,7 @@ public:
 	 * Called to unload a level and reload it
 	 * @author Richard Wulansari
 	 * @param _loadLevelInfo: The level loading information
+	 * @note A level with a snapshot is restored in memory once the screen has faded out, the first reset of a level reloads it
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Respawn System")
 	void ResetStreamingLevel(FLoadStreamingLevelInfo _loadLevelInfo);
@@ -142,9 +239,57 @@ public:
 	 * @param _districtType
 	 * @param _transform
 	 * @param _locationName
+	 * @param _bCheckpoint: Whether it can be used for a quick retry
+	 * @note A location registered again under the same name, e.g. when its level is reloaded, replaces the previous one
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void RegisterRespawnLocation(EDISTRICT _districtType, FTransform _transform, FString _locationName, bool _bCheckpoint = false);
+
+	/**
+	 * Gets the respawn location nearest to a location in any district
+	 * @author Richard Wulansari
+	 * @param _location
+	 * @param _outLocation
+	 * @return False if there is no respawn location
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Respawn System")
-	void RegisterRespawnLocation(EDISTRICT _districtType, FTransform _transform, FString _locationName);
+	bool GetNearestRespawnLocation(FVector _location, FRespawnLocationInfo& _outLocation) const;
+
+	/**
+	 * Gets the nearest checkpoint the player can walk to from a location
+	 * @author Richard Wulansari
+	 * @param _location: e.g. where the player has been caught
+	 * @param _outLocation
+	 * @return False if there is no reachable checkpoint within the search radius
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	bool GetNearestReachableCheckpoint(FVector _location, FRespawnLocationInfo& _outLocation) const;
+
+	/**
+	 * Finds a respawn location by name
+	 * @author Richard Wulansari
+	 * @param _district
+	 * @param _locationName
+	 * @return Null if the district has no location with the name
+	 */
+	const FRespawnLocationInfo* FindRespawnLocation(EDISTRICT _district, FName _locationName) const;
+
+	/**
+	 * Finds the respawn location nearest to a location through the grid
+	 * @author Richard Wulansari
+	 * @param _location
+	 * @param _bCheckpointsOnly
+	 * @return Null if there is no respawn location
+	 */
+	const FRespawnLocationInfo* FindNearestRespawnLocation(const FVector& _location, bool _bCheckpointsOnly = false) const;
+
+	/**
+	 * Finds the nearest checkpoint within the search radius that has a complete navigation path from a location
+	 * @author Richard Wulansari
+	 * @param _location
+	 * @return Null if there is no reachable checkpoint
+	 */
+	const FRespawnLocationInfo* FindNearestReachableCheckpoint(const FVector& _location) const;
 
 	/**
 	 * Gets the first respawn location at provided district type
@@ -169,10 +314,41 @@ public:
 	 * @author Richard Wulansari
 	 * @param _district: District that needs to be loaded
 	 * @param _locationName: The respawn location name
+	 * @note The loading starts together with the fade out, the player is moved while the screen is black
+	 * @note Levels of the district that are already visible or resident, e.g. respawning in the same district, are reset
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Respawn System")
 	void RespawnPlayerAtDistrict(EDISTRICT _district, FString _locationName);
 
+	/**
+	 * Register the widget that fades the screen out during a district transition
+	 * The player is moved once the fade has finished and the district has loaded, whichever is later
+	 * @author Richard Wulansari
+	 * @param _fadeWidget: Its OnEffectFinish has to be called at the end of the fade
+	 * @note Without a widget the fade out is assumed to take TransitionFadeOutTime
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void RegisterTransitionFadeWidget(class UFadeEffectWidget* _fadeWidget);
+
+	/**
+	 * Loads the levels of a district in the background without making them visible
+	 * A following respawn at the district only has to make them visible
+	 * @author Richard Wulansari
+	 * @param _district: District that is likely to be loaded next
+	 * @return False if the prefetch has been skipped, it must not be released then
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	bool PrefetchDistrict(EDISTRICT _district);
+
+	/**
+	 * Releases a prefetch of a district, its levels are unloaded if nothing else needs them
+	 * @author Richard Wulansari
+	 * @param _district: District that has been prefetched
+	 * @note Levels that has been made visible are kept
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Respawn System")
+	void ReleasePrefetchedDistrict(EDISTRICT _district);
+
 	/**
 	 * Gets the instance without going through the GameInstance
 	 * @author Richard Wulansari
@@ -209,16 +385,87 @@ protected:
 	UFUNCTION()
 	void OnStreamLevelResetReloadFinish();
 
+	/** Unloads the level of the reset, it is loaded again once the unload has finished */
+	void UnloadResetLevel();
+
+	/** Restores the level of the reset from its snapshot, reloads it if the snapshot is gone */
+	void RestoreResetLevel();
+
+	/** Fades the screen out, OnTransitionFadeOutFinished is called at the end */
+	void StartTransitionFade();
+
 
 	// Multiple Level loading support
 
+	/** Called when any of the district levels has finished loading */
 	UFUNCTION()
 	void OnDistrictRequireLevelLoaded();
 
+	/** Called when any of the district levels has finished unloading */
 	UFUNCTION()
 	void OnDistrictRequireLevelUnloaded();
 
-	void OnDisctrictLoaded(FDistrictInfo _loadingDistrictInfo, FString _respawnLocationName);
+	/** Starts loading every waiting level that has no pending dependency */
+	void IssueReadyDistrictLoads();
+
+	/** Requests a district level to load and be made visible */
+	void IssueDistrictLoad(FName _levelName);
+
+	/** Hides and unloads the levels the district does not need */
+	void IssueDistrictUnloads();
+
+	/** Called when the screen has faded out, the levels the player could see can be removed now */
+	UFUNCTION()
+	void OnTransitionFadeOutFinished();
+
+	/**
+	 * Overrides the engine streaming settings with the policy of the district being loaded
+	 * @author Richard Wulansari
+	 * @param _policy
+	 * @note The previous settings are kept until RestoreStreamingSettings
+	 */
+	void ApplyStreamingPolicy(const FDistrictStreamingPolicy& _policy);
+
+	/** Puts back the engine streaming settings a district policy has overridden */
+	void RestoreStreamingSettings();
+
+	/** Requests the preload assets of a district, the handle is held until the district is no longer resident */
+	void PreloadDistrictAssets(EDISTRICT _district);
+
+	/**
+	 * Releases the preload assets of the districts that has no level left loaded after a transition
+	 * @author Richard Wulansari
+	 * @param _district: The district being loaded
+	 * @param _levelsToEvict: The levels the transition unloads
+	 */
+	void ReleaseEvictedDistrictPreloads(EDISTRICT _district, const TArray<FName>& _levelsToEvict);
+
+	/** Adds the assets the loaded levels of a district use to its preload assets, only done once per district */
+	void CollectDistrictPreloadAssets(EDISTRICT _district);
+
+	/** Finishes the district transition once all the streaming requests and the post load work are done and the fade out is complete */
+	void TryFinishDistrictTransition();
+
+	/**
+	 * Check if a level can start loading
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 * @return False if the level is still unloading or a dependency has not finished loading
+	 */
+	bool CanIssueDistrictLoad(FName _levelName) const;
+
+	/** Makes a latent action info that calls back the function on this system with a unique UUID */
+	FLatentActionInfo MakeStreamingLatentInfo(FName _executionFunction);
+
+	/**
+	 * Gets the streaming level object by name, the result is cached
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 * @return Null if the level is not part of the current world
+	 */
+	class ULevelStreaming* FindStreamingLevel(FName _levelName) const;
+
+	void OnDisctrictLoaded(EDISTRICT _district, FName _respawnLocationName);
 
 
 private:
@@ -230,6 +477,15 @@ private:
 	 * @param _respawnLocationName: Location name
 	 * @return The respawn transform
 	 */
-	FTransform GetRespawnTransform(FDistrictInfo _loadingDistrictInfo, FString _respawnLocationName) const;
+	const FTransform& GetRespawnTransform(const FDistrictInfo& _loadingDistrictInfo, FName _respawnLocationName) const;
+
+	/** Gets the grid cell a location is in */
+	static FIntPoint GetRespawnCell(const FVector& _location);
+
+	/** Gets a respawn location from its handle */
+	FORCEINLINE const FRespawnLocationInfo& GetRespawnLocation(const FRespawnLocationHandle& _handle) const
+	{
+		return Districts[(int32)_handle.District].RespawnLocations[_handle.Index];
+	}
 
 };
\ No newline at end of file
@@ -36,9 +36,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FTransform RespawnTransform;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EDISTRICT District;
+
+	/** Checkpoints are used for quick retries near the place the player failed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bCheckpoint;
+
 	FRespawnLocationInfo() :
 		LocationName(TEXT("DefaultName")),
-		RespawnTransform(FTransform::Identity)
+		RespawnTransform(FTransform::Identity),
+		District(EDISTRICT::HUB),
+		bCheckpoint(false)
 	{}
 };
 
@@ -80,6 +89,46 @@ public:
 	{}
 };
 
+/**
+ * How the levels of a district are streamed while the district is being loaded
+ * Zero or negative values keep the engine setting
+ */
+USTRUCT(BlueprintType)
+struct FDistrictStreamingPolicy
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Levels with a higher priority are considered for streaming first */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 LoadPriority;
+
+	/** The time the async loading may take each frame in milliseconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float AsyncLoadingTimeLimitMs;
+
+	/** The time adding the loaded levels to the world may take each frame in milliseconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float AddToWorldTimeSliceMs;
+
+	/** The number of components registered at once while adding a level to the world */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 ComponentRegistrationGranularity;
+
+	/** Loads the levels in one go once the screen has faded out, for districts behind a loading screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bBlockOnLoad;
+
+	FDistrictStreamingPolicy() :
+		LoadPriority(0),
+		AsyncLoadingTimeLimitMs(0.0f),
+		AddToWorldTimeSliceMs(0.0f),
+		ComponentRegistrationGranularity(0),
+		bBlockOnLoad(false)
+	{}
+};
+
 /**
  *
  */
@@ -99,7 +148,21 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FRespawnLocationInfo> RespawnLocations;
 
+	/** The index of each respawn location by name */
+	TMap<FName, int32> RespawnLocationIndices;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FDistrictStreamingPolicy StreamingPolicy;
+
+	/** The assets loaded asynchronously while the district levels stream, so they are not loaded on first use */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<TSoftObjectPtr<UObject>> PreloadAssets;
+
+	/** True once the assets of the district levels has been added to the preload assets */
+	bool bPreloadAssetsCollected;
+
 	FDistrictInfo() :
-		RespawnDistrictType(EDISTRICT::HUB)
+		RespawnDistrictType(EDISTRICT::HUB),
+		bPreloadAssetsCollected(false)
 	{}
 };
\ No newline at end of file
@@ -0,0 +1,292 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "StreamingTelemetrySubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+
+#include "DebugUtility/CatastropheDebug.h"
+
+UStreamingTelemetrySubsystem::UStreamingTelemetrySubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UStreamingTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	LevelAddedToWorldHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+		this, &UStreamingTelemetrySubsystem::OnLevelAddedToWorld);
+	bInitialized = true;
+}
+
+void UStreamingTelemetrySubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedToWorldHandle);
+	bInitialized = false;
+	bRecordingTransition = false;
+	LevelRecords.Empty();
+}
+
+void UStreamingTelemetrySubsystem::Tick(float DeltaTime)
+{
+	// The load phases have no events of their own, the state of each level is polled instead
+	UWorld* world = GetTickableGameObjectWorld();
+	ULevel* levelPendingVisibility = world ? world->GetCurrentLevelPendingVisibility() : nullptr;
+	for (FLevelStreamingRecord& record : LevelRecords)
+	{
+		ULevelStreaming* streamLevel = record.StreamingLevel.Get();
+		if (!streamLevel)
+			continue;
+
+		if (record.PackageLoadedTime < 0.0f && streamLevel->IsLevelLoaded())
+		{
+			record.PackageLoadedTime = GetTimeSince(record.RequestTime);
+		}
+
+		if (record.AddToWorldTime < 0.0f &&
+			levelPendingVisibility &&
+			levelPendingVisibility == streamLevel->GetLoadedLevel())
+		{
+			record.AddToWorldTime = GetTimeSince(record.RequestTime);
+		}
+	}
+}
+
+bool UStreamingTelemetrySubsystem::IsTickable() const
+{
+	// The class default object should never tick
+	return bInitialized && bRecordingTransition && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+UWorld* UStreamingTelemetrySubsystem::GetTickableGameObjectWorld() const
+{
+	UGameInstance* gameInst = Cast<UGameInstance>(GetOuter());
+	return gameInst ? gameInst->GetWorld() : nullptr;
+}
+
+TStatId UStreamingTelemetrySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStreamingTelemetrySubsystem, STATGROUP_Tickables);
+}
+
+void UStreamingTelemetrySubsystem::BeginTransition(EDISTRICT _district)
+{
+	bRecordingTransition = true;
+	RecordingDistrict = _district;
+	TransitionStartTime = FPlatformTime::Seconds();
+	MemoryBeforeTransition = FPlatformMemory::GetStats().UsedPhysical;
+	LevelRecords.Reset();
+}
+
+void UStreamingTelemetrySubsystem::RecordLevelRequested(FName _levelName, ULevelStreaming* _streamingLevel)
+{
+	if (!bRecordingTransition) return;
+
+	FLevelStreamingRecord record;
+	record.LevelName = _levelName;
+	record.StreamingLevel = _streamingLevel;
+	record.RequestTime = FPlatformTime::Seconds();
+	LevelRecords.Add(record);
+}
+
+void UStreamingTelemetrySubsystem::RecordLevelVisible(FName _levelName)
+{
+	if (!bRecordingTransition) return;
+
+	for (FLevelStreamingRecord& record : LevelRecords)
+	{
+		if (record.LevelName == _levelName && record.VisibleTime < 0.0f)
+		{
+			record.VisibleTime = GetTimeSince(record.RequestTime);
+
+			// A level that was already loaded or added within a frame skips the earlier phases
+			if (record.BeginPlayTime < 0.0f) record.BeginPlayTime = record.VisibleTime;
+			if (record.AddToWorldTime < 0.0f) record.AddToWorldTime = record.BeginPlayTime;
+			if (record.PackageLoadedTime < 0.0f) record.PackageLoadedTime = record.AddToWorldTime;
+			return;
+		}
+	}
+}
+
+void UStreamingTelemetrySubsystem::EndTransition()
+{
+	if (!bRecordingTransition) return;
+
+	bRecordingTransition = false;
+	const float transitionTime = GetTimeSince(TransitionStartTime);
+	const uint64 memoryAfterTransition = FPlatformMemory::GetStats().UsedPhysical;
+
+	TransitionSamples.FindOrAdd(RecordingDistrict).Add(transitionTime * 1000.0f);
+	for (const FLevelStreamingRecord& record : LevelRecords)
+	{
+		if (record.VisibleTime < 0.0f)
+			continue;
+
+		LevelSamples.FindOrAdd(record.LevelName).Add(record.VisibleTime * 1000.0f);
+		LevelDistricts.Add(record.LevelName, RecordingDistrict);
+	}
+
+	WriteTransitionToCsv(transitionTime, memoryAfterTransition);
+	LevelRecords.Reset();
+}
+
+FStreamingTimeSummary UStreamingTelemetrySubsystem::GetDistrictSummary(EDISTRICT _district) const
+{
+	const TArray<float>* samples = TransitionSamples.Find(_district);
+	return samples ? MakeSummary(*samples) : FStreamingTimeSummary();
+}
+
+FStreamingTimeSummary UStreamingTelemetrySubsystem::GetLevelSummary(FName _levelName) const
+{
+	const TArray<float>* samples = LevelSamples.Find(_levelName);
+	return samples ? MakeSummary(*samples) : FStreamingTimeSummary();
+}
+
+void UStreamingTelemetrySubsystem::PrintStreamingStats() const
+{
+	for (const TPair<EDISTRICT, TArray<float>>& districtSamples : TransitionSamples)
+	{
+		const FStreamingTimeSummary summary = MakeSummary(districtSamples.Value);
+
+		// The slowest level of the district by its 90th percentile
+		FName slowestLevel = NAME_None;
+		FStreamingTimeSummary slowestSummary;
+		for (const TPair<FName, EDISTRICT>& levelDistrict : LevelDistricts)
+		{
+			if (levelDistrict.Value != districtSamples.Key)
+				continue;
+
+			const FStreamingTimeSummary levelSummary = GetLevelSummary(levelDistrict.Key);
+			if (slowestLevel.IsNone() || levelSummary.P90 > slowestSummary.P90)
+			{
+				slowestLevel = levelDistrict.Key;
+				slowestSummary = levelSummary;
+			}
+		}
+
+		CatastropheDebug::OnScreenDebugMsg(-1, 15.0f, FColor::Cyan,
+			FString::Printf(TEXT("%s: n=%d p50=%.0fms p90=%.0fms p99=%.0fms max=%.0fms, slowest %s p90=%.0fms"),
+				*GetDistrictName(districtSamples.Key),
+				summary.SampleCount, summary.P50, summary.P90, summary.P99, summary.Max,
+				*slowestLevel.ToString(), slowestSummary.P90));
+	}
+
+	if (!SessionCsvPath.IsEmpty())
+	{
+		CatastropheDebug::OnScreenDebugMsg(-1, 15.0f, FColor::Cyan,
+			FString::Printf(TEXT("Streaming telemetry: %s"), *SessionCsvPath));
+	}
+}
+
+UStreamingTelemetrySubsystem* UStreamingTelemetrySubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UStreamingTelemetrySubsystem>();
+	}
+	return nullptr;
+}
+
+void UStreamingTelemetrySubsystem::OnLevelAddedToWorld(ULevel* _level, UWorld* _world)
+{
+	if (!bRecordingTransition || _world != GetTickableGameObjectWorld()) return;
+
+	for (FLevelStreamingRecord& record : LevelRecords)
+	{
+		ULevelStreaming* streamLevel = record.StreamingLevel.Get();
+		if (streamLevel && streamLevel->GetLoadedLevel() == _level && record.BeginPlayTime < 0.0f)
+		{
+			record.BeginPlayTime = GetTimeSince(record.RequestTime);
+			if (record.AddToWorldTime < 0.0f) record.AddToWorldTime = record.BeginPlayTime;
+			if (record.PackageLoadedTime < 0.0f) record.PackageLoadedTime = record.AddToWorldTime;
+			return;
+		}
+	}
+}
+
+void UStreamingTelemetrySubsystem::WriteTransitionToCsv(float _transitionTime, uint64 _memoryAfterTransition)
+{
+#if !UE_BUILD_SHIPPING
+	FString rows;
+	if (SessionCsvPath.IsEmpty())
+	{
+		SessionCsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), TEXT("Streaming"),
+			FString::Printf(TEXT("StreamingTelemetry-%s.csv"), *FDateTime::Now().ToString()));
+		rows += TEXT("District,Level,PackageLoadedMs,AddToWorldMs,BeginPlayMs,VisibleMs,TransitionMs,MemoryBeforeMB,MemoryAfterMB\n");
+	}
+
+	const FString districtName = GetDistrictName(RecordingDistrict);
+	const float memoryBefore = MemoryBeforeTransition / (1024.0f * 1024.0f);
+	const float memoryAfter = _memoryAfterTransition / (1024.0f * 1024.0f);
+
+	// One row per level load, the district row has no level so a transition without loads is still recorded
+	rows += FString::Printf(TEXT("%s,,,,,,%.2f,%.1f,%.1f\n"),
+		*districtName, _transitionTime * 1000.0f, memoryBefore, memoryAfter);
+	for (const FLevelStreamingRecord& record : LevelRecords)
+	{
+		rows += FString::Printf(TEXT("%s,%s,%.2f,%.2f,%.2f,%.2f,%.2f,%.1f,%.1f\n"),
+			*districtName,
+			*record.LevelName.ToString(),
+			record.PackageLoadedTime * 1000.0f,
+			record.AddToWorldTime * 1000.0f,
+			record.BeginPlayTime * 1000.0f,
+			record.VisibleTime * 1000.0f,
+			_transitionTime * 1000.0f,
+			memoryBefore,
+			memoryAfter);
+	}
+
+	if (!FFileHelper::SaveStringToFile(rows, *SessionCsvPath,
+		FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Error, TEXT("StreamingTelemetry: Failed to write %s"), *SessionCsvPath);
+	}
+#endif
+}
+
+float UStreamingTelemetrySubsystem::GetTimeSince(double _startTime)
+{
+	return (float)(FPlatformTime::Seconds() - _startTime);
+}
+
+FStreamingTimeSummary UStreamingTelemetrySubsystem::MakeSummary(const TArray<float>& _samples)
+{
+	FStreamingTimeSummary summary;
+	if (_samples.Num() == 0) return summary;
+
+	TArray<float> sortedSamples = _samples;
+	sortedSamples.Sort();
+
+	// Nearest rank percentile
+	auto getPercentile = [&sortedSamples](float _percentile)
+	{
+		const int32 rank = FMath::CeilToInt(_percentile * sortedSamples.Num()) - 1;
+		return sortedSamples[FMath::Clamp(rank, 0, sortedSamples.Num() - 1)];
+	};
+
+	summary.SampleCount = sortedSamples.Num();
+	summary.P50 = getPercentile(0.5f);
+	summary.P90 = getPercentile(0.9f);
+	summary.P99 = getPercentile(0.99f);
+	summary.Max = sortedSamples.Last();
+	return summary;
+}
+
+FString UStreamingTelemetrySubsystem::GetDistrictName(EDISTRICT _district)
+{
+	const UEnum* enumPtr = FindObject<UEnum>(ANY_PACKAGE, TEXT("EDISTRICT"), true);
+	return enumPtr ? enumPtr->GetNameStringByIndex((int32)_district) : FString::FromInt((int32)_district);
+}
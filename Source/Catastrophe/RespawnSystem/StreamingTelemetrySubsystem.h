@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "RespawnSystemTypes.h"
+#include "StreamingTelemetrySubsystem.generated.h"
+
+/**
+ * The timestamps of one level load in a district transition, in seconds since the request
+ * A phase that has not been reached is negative
+ */
+struct FLevelStreamingRecord
+{
+	FName LevelName;
+
+	TWeakObjectPtr<class ULevelStreaming> StreamingLevel;
+
+	/** The platform time the load was requested at */
+	double RequestTime = 0.0;
+
+	/** The package has finished loading asynchronously */
+	float PackageLoadedTime = -1.0f;
+
+	/** The level started being added to the world */
+	float AddToWorldTime = -1.0f;
+
+	/** The actors of the level has begun play, this is the end of AddToWorld */
+	float BeginPlayTime = -1.0f;
+
+	/** The respawn system has seen the level as visible */
+	float VisibleTime = -1.0f;
+};
+
+/**
+ * The summary of a set of load time samples in milliseconds
+ */
+USTRUCT(BlueprintType)
+struct FStreamingTimeSummary
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SampleCount;
+
+	UPROPERTY(BlueprintReadOnly)
+	float P50;
+
+	UPROPERTY(BlueprintReadOnly)
+	float P90;
+
+	UPROPERTY(BlueprintReadOnly)
+	float P99;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Max;
+
+	FStreamingTimeSummary() :
+		SampleCount(0),
+		P50(0.0f),
+		P90(0.0f),
+		P99(0.0f),
+		Max(0.0f)
+	{}
+};
+
+/**
+ * This system records the timing of every district transition of the respawn system
+ * Each level load is timestamped per phase, the results are appended to a csv file per session
+ * and kept as samples for the percentile summaries shown in game
+ * It only ticks while a transition is being recorded
+ */
+UCLASS()
+class CATASTROPHE_API UStreamingTelemetrySubsystem : public UCatastropheGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UStreamingTelemetrySubsystem();
+
+protected:
+
+	bool bInitialized = false;
+
+	/** True between BeginTransition and EndTransition */
+	bool bRecordingTransition = false;
+
+	EDISTRICT RecordingDistrict = EDISTRICT::HUB;
+
+	double TransitionStartTime = 0.0;
+
+	/** Used physical memory at the start of the transition in bytes */
+	uint64 MemoryBeforeTransition = 0;
+
+	/** The level loads of the current transition */
+	TArray<FLevelStreamingRecord> LevelRecords;
+
+	/** The transition times in milliseconds by district */
+	TMap<EDISTRICT, TArray<float>> TransitionSamples;
+
+	/** The request to visible times in milliseconds by level */
+	TMap<FName, TArray<float>> LevelSamples;
+
+	/** The district each level was last loaded for */
+	TMap<FName, EDISTRICT> LevelDistricts;
+
+	/** The csv file of this session, created with the first transition */
+	FString SessionCsvPath;
+
+	FDelegateHandle LevelAddedToWorldHandle;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObject interface */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	/** FTickableGameObject interface End */
+
+	/**
+	 * Starts recording a district transition, an unfinished recording is discarded
+	 * @author Richard Wulansari
+	 * @param _district The district that is being loaded
+	 */
+	void BeginTransition(EDISTRICT _district);
+
+	/**
+	 * Records the load request of a level
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 * @param _streamingLevel The streaming level object, its state is polled for the load phases
+	 */
+	void RecordLevelRequested(FName _levelName, class ULevelStreaming* _streamingLevel);
+
+	/**
+	 * Records that a level has been seen as visible by the respawn system
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 */
+	void RecordLevelVisible(FName _levelName);
+
+	/**
+	 * Finishes the recording, writes it to the csv file and adds the samples
+	 * @author Richard Wulansari
+	 */
+	void EndTransition();
+
+	/**
+	 * Gets the percentile summary of the transition times of a district
+	 * @author Richard Wulansari
+	 * @param _district
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Telemetry")
+	FStreamingTimeSummary GetDistrictSummary(EDISTRICT _district) const;
+
+	/**
+	 * Gets the percentile summary of the load times of a level
+	 * @author Richard Wulansari
+	 * @param _levelName
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Telemetry")
+	FStreamingTimeSummary GetLevelSummary(FName _levelName) const;
+
+	/**
+	 * Prints the summary of each district and its slowest level on screen
+	 * @author Richard Wulansari
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Streaming Telemetry")
+	void PrintStreamingStats() const;
+
+	/** Gets the instance without going through the GameInstance */
+	static UStreamingTelemetrySubsystem* GetInst(const UObject* _worldContextObject);
+
+	/** Getter */
+	FORCEINLINE const FString& GetSessionCsvPath() const { return SessionCsvPath; }
+	/** Getter End */
+
+private:
+
+	/** Called by the engine when a level has finished being added to a world */
+	void OnLevelAddedToWorld(class ULevel* _level, class UWorld* _world);
+
+	/** Appends the current recording to the csv file of the session */
+	void WriteTransitionToCsv(float _transitionTime, uint64 _memoryAfterTransition);
+
+	/** Gets the seconds since a platform time */
+	static float GetTimeSince(double _startTime);
+
+	/** Summarizes a set of samples */
+	static FStreamingTimeSummary MakeSummary(const TArray<float>& _samples);
+
+	static FString GetDistrictName(EDISTRICT _district);
+
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ViewContextSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Camera/CameraComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+
+#include "Components/CharacterSprintMovementComponent.h"
+#include "Gameplay/GameMode/CatastropheMainGameMode.h"
+#include "Gameplay/CaveGameplay/CaveCameraTrack.h"
+
+UViewContextSubsystem::UViewContextSubsystem()
+	: UCatastropheGameInstanceSubsystem()
+{}
+
+void UViewContextSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bInitialized = true;
+}
+
+void UViewContextSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+
+	bInitialized = false;
+	ViewContext = FGameplayViewContext();
+}
+
+void UViewContextSubsystem::Tick(float DeltaTime)
+{
+	UWorld* world = GetTickableGameObjectWorld();
+	APlayerCharacter* playerCharacter = Cast<APlayerCharacter>(UGameplayStatics::GetPlayerCharacter(world, 0));
+	APlayerCameraManager* cameraManager = UGameplayStatics::GetPlayerCameraManager(world, 0);
+	if (!playerCharacter || !cameraManager)
+	{
+		ViewContext.bValid = false;
+		return;
+	}
+
+	FGameplayViewContext newContext;
+	newContext.bValid = true;
+	newContext.FrameNumber = GFrameCounter;
+	newContext.CameraLocation = cameraManager->GetCameraLocation();
+	newContext.CameraRotation = cameraManager->GetCameraRotation();
+	newContext.PlayerLocation = playerCharacter->GetActorLocation();
+	newContext.PlayerVelocity = playerCharacter->GetVelocity();
+	newContext.bPlayerCrouching = playerCharacter->GetCharacterMovement()->IsCrouching();
+	newContext.bPlayerSprinting = playerCharacter->GetSprintMovementComponent()->IsSprinting();
+	newContext.MovementSet = playerCharacter->CurrentMovementSet;
+
+	// Resolve the cave track camera once here instead of every movement input
+	// Done whenever the track exists so the yaw is ready on the first frame of the chase
+	ACatastropheMainGameMode* mainGameMode = ACatastropheMainGameMode::GetGameModeInst(world);
+	ACaveCameraTrack* caveCameraTrack = mainGameMode ? mainGameMode->GetCaveCameraTrack() : nullptr;
+	if (caveCameraTrack)
+	{
+		const FVector trackCameraLocation = caveCameraTrack->GetTrackFollowCamera()->GetComponentLocation();
+		newContext.CaveChaseMovementYaw =
+			UKismetMathLibrary::FindLookAtRotation(trackCameraLocation, newContext.PlayerLocation).Yaw;
+	}
+
+	ViewContext = newContext;
+}
+
+bool UViewContextSubsystem::IsTickable() const
+{
+	// The class default object should never tick
+	return bInitialized && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+UWorld* UViewContextSubsystem::GetTickableGameObjectWorld() const
+{
+	UGameInstance* gameInst = Cast<UGameInstance>(GetOuter());
+	return gameInst ? gameInst->GetWorld() : nullptr;
+}
+
+TStatId UViewContextSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UViewContextSubsystem, STATGROUP_Tickables);
+}
+
+UViewContextSubsystem* UViewContextSubsystem::GetInst(const UObject* _worldContextObject)
+{
+	if (UGameInstance* gameInst
+		= UGameplayStatics::GetGameInstance(_worldContextObject))
+	{
+		return gameInst->GetSubsystem<UViewContextSubsystem>();
+	}
+	return nullptr;
+}
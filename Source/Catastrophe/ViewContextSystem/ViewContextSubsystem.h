@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "GameInstance/CatastropheGameInstanceSubsystem.h"
+#include "Characters/PlayerCharacter/PlayerCharacter.h"
+#include "ViewContextSubsystem.generated.h"
+
+/**
+ * A snapshot of the camera and the player for the current frame
+ * Read this instead of looking up the camera manager or the player every tick
+ */
+USTRUCT(BlueprintType)
+struct FGameplayViewContext
+{
+	GENERATED_BODY()
+
+public:
+
+	/** False until the player and its camera has been found */
+	UPROPERTY(BlueprintReadOnly)
+	bool bValid;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector CameraLocation;
+
+	UPROPERTY(BlueprintReadOnly)
+	FRotator CameraRotation;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector PlayerLocation;
+
+	UPROPERTY(BlueprintReadOnly)
+	FVector PlayerVelocity;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bPlayerCrouching;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bPlayerSprinting;
+
+	UPROPERTY(BlueprintReadOnly)
+	EPlayerMovementSet MovementSet;
+
+	/** The yaw the player moves forward with during the cave chase, facing away from the track camera */
+	UPROPERTY(BlueprintReadOnly)
+	float CaveChaseMovementYaw;
+
+	/** The frame this snapshot is taken */
+	uint64 FrameNumber;
+
+	FGameplayViewContext() :
+		bValid(false),
+		CameraLocation(0.0f, 0.0f, 0.0f),
+		CameraRotation(0.0f, 0.0f, 0.0f),
+		PlayerLocation(0.0f, 0.0f, 0.0f),
+		PlayerVelocity(0.0f, 0.0f, 0.0f),
+		bPlayerCrouching(false),
+		bPlayerSprinting(false),
+		MovementSet(EPlayerMovementSet::NORMAL),
+		CaveChaseMovementYaw(0.0f),
+		FrameNumber(0)
+	{}
+};
+
+/**
+ * This system takes a snapshot of the camera and the player once per frame
+ * The snapshot is taken after the camera update, so during the next frame every system reads the same values
+ */
+UCLASS()
+class CATASTROPHE_API UViewContextSubsystem : public UCatastropheGameInstanceSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UViewContextSubsystem();
+
+protected:
+
+	/** The snapshot of the last finished frame */
+	FGameplayViewContext ViewContext;
+
+	bool bInitialized = false;
+
+public:
+
+	/** Implement this for initialization of instances of the system */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Implement this for deinitialization of instances of the system */
+	virtual void Deinitialize() override;
+
+	/** FTickableGameObject interface */
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+	/** FTickableGameObject interface End */
+
+	/** Gets the instance without going through the GameInstance */
+	static UViewContextSubsystem* GetInst(const UObject* _worldContextObject);
+
+	/** Getter */
+	FORCEINLINE const FGameplayViewContext& GetViewContext() const { return ViewContext; }
+	/** Getter End */
+
+};